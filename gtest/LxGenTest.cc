@@ -0,0 +1,844 @@
+
+/// @file LxGenTest.cc
+/// @brief LxGenTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "LxGen.h"
+#include "BasisChecker.h"
+#include "RvMgr.h"
+#include "RvMatrix.h"
+#include "Variable.h"
+#include "VarTable.h"
+#include "VarPool.h"
+#include "RandStream.h"
+#include <unordered_map>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_IGF
+
+BEGIN_NONAMESPACE
+
+// テスト用のデータを作る．
+// 変数 j が 1 となる確率は (j + 1) / (bitlen + 1) とする．
+string
+make_data(ymuint bitlen,
+	  ymuint n)
+{
+  ostringstream os;
+  os << bitlen << " " << n << endl;
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint64 x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      x ^= (x << 13);
+      x ^= (x >> 7);
+      x ^= (x << 17);
+      os << (((x >> 11) % (bitlen + 1) <= j) ? '1' : '0');
+    }
+    os << endl;
+  }
+  return os.str();
+}
+
+// 変数の価値(n0 * n1)を 64ビットで求める．
+ymuint64
+score(const RvMatrix& rv_mat,
+      const Variable& var)
+{
+  ymuint64 nv = rv_mat.vect_num();
+  ymuint64 n1 = rv_mat.count1(var);
+  return (nv - n1) * n1;
+}
+
+// var_list によって分離されるベクタの対の数を求める．
+ymuint64
+sep_num(const RvMatrix& rv_mat,
+	const vector<Variable>& var_list,
+	ymuint n)
+{
+  ymuint64 nv = rv_mat.vect_num();
+  std::unordered_map<string, ymuint64> count_map;
+  for (ymuint pos = 0; pos < nv; ++ pos) {
+    string sig(n, '0');
+    for (ymuint i = 0; i < n; ++ i) {
+      if ( rv_mat.classify(pos, var_list[i]) ) {
+	sig[i] = '1';
+      }
+    }
+    ++ count_map[sig];
+  }
+  ymuint64 ans = nv * (nv - 1) / 2;
+  for (auto p: count_map) {
+    ans -= p.second * (p.second - 1) / 2;
+  }
+  return ans;
+}
+
+// 登録ベクタを区別するプライマリ変数のリストを作る．
+vector<Variable>
+primary_list(const RvMatrix& rv_mat)
+{
+  ymuint var_num = rv_mat.vect_size();
+  ymuint64 nv = rv_mat.vect_num();
+  vector<Variable> var_list;
+  for (ymuint i = 0; i < var_num; ++ i) {
+    Variable var(var_num, i);
+    ymuint64 n1 = rv_mat.count1(var);
+    if ( n1 > 0 && n1 < nv ) {
+      var_list.push_back(var);
+    }
+  }
+  return var_list;
+}
+
+// MCMC 系の生成器の連鎖の参照実装
+// 連鎖番号 cid の乱数は rs.split(cid) から作る．
+struct RefChain
+{
+  RefChain(const RvMatrix& rv_mat,
+	   const vector<Variable>& primary_list,
+	   const RandStream& rs,
+	   ymuint cid) :
+    mRvMat(rv_mat),
+    mPrimaryList(primary_list)
+  {
+    RandStream rs1 = rs.split(cid);
+    mRgMove = rs1.split(0);
+    mRgAccept = rs1.split(1);
+    ymuint var_num = rv_mat.vect_size();
+    mCurVar = Variable(var_num, mRgMove.int32() % var_num);
+    mCurVal = value(mCurVar);
+  }
+
+  double
+  value(const Variable& var)
+  {
+    ymuint64 nv = mRvMat.vect_num();
+    ymuint64 n1 = mRvMat.count1(var);
+    return Variable::calc_value(nv - n1, n1);
+  }
+
+  // 遷移する．
+  // temp が 0.0 の時は価値の比で，それ以外は温度で受容判定を行う．
+  void
+  move(double temp)
+  {
+    ymuint pos = mRgMove.int32() % mPrimaryList.size();
+    Variable new_var = mCurVar * mPrimaryList[pos];
+    double new_val = value(new_var);
+    if ( new_val < mCurVal ) {
+      double r = mRgAccept.real1();
+      double limit = temp == 0.0 ? new_val / mCurVal : exp((new_val - mCurVal) / temp);
+      if ( r > limit ) {
+	return;
+      }
+    }
+    mCurVar = new_var;
+    mCurVal = new_val;
+  }
+
+  const RvMatrix& mRvMat;
+  const vector<Variable>& mPrimaryList;
+  RandStream mRgMove;
+  RandStream mRgAccept;
+  Variable mCurVar;
+  double mCurVal;
+};
+
+// MCMC の1連鎖を逐次的に動かす参照実装
+// 訪れた状態(初期状態を含む)をすべて var_pool に入れる．
+void
+mcmc_chain(const RvMatrix& rv_mat,
+	   const RandStream& rs,
+	   ymuint cid,
+	   ymuint step_num,
+	   VarPool& var_pool)
+{
+  vector<Variable> p_list = primary_list(rv_mat);
+  RefChain chain(rv_mat, p_list, rs, cid);
+  var_pool.put(chain.mCurVar, chain.mCurVal);
+  for (ymuint i = 0; i < step_num; ++ i) {
+    chain.move(0.0);
+    var_pool.put(chain.mCurVar, chain.mCurVal);
+  }
+}
+
+END_NONAMESPACE
+
+// n0 * n1 が 32ビットに収まらない大きさのデータに対する Shift のテスト
+//
+// Shift は最小の価値を持つ変数を改善できなくなるまで置き換えるので，
+// 結果の中の価値最小の変数のどれかは局所最適になっていなければならない．
+TEST(LxGenTest, Shift_large)
+{
+  ymuint bitlen = 40;
+  ymuint n = 140000;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  ymuint nv = rv_mat.vect_num();
+  ASSERT_LT( 0xFFFFFFFFULL, static_cast<ymuint64>(nv / 2) * (nv - nv / 2) );
+
+  LxGen* lxgen = LxGen::new_obj("Shift");
+  ASSERT_TRUE( lxgen != nullptr );
+  vector<Variable> var_list;
+  lxgen->generate(rv_mgr.vect_list(), bitlen, var_list);
+  delete lxgen;
+  ASSERT_FALSE( var_list.empty() );
+
+  // 初期の変数集合の最小値より悪くなることはない．
+  ymuint64 min_prim = 0;
+  for (ymuint i = 0; i < bitlen; ++ i) {
+    ymuint64 s = score(rv_mat, Variable(bitlen, i));
+    if ( s > 0 && (min_prim == 0 || min_prim > s) ) {
+      min_prim = s;
+    }
+  }
+  ymuint64 min_n = score(rv_mat, var_list[0]);
+  for (ymuint k = 1; k < var_list.size(); ++ k) {
+    ymuint64 s = score(rv_mat, var_list[k]);
+    if ( min_n > s ) {
+      min_n = s;
+    }
+  }
+  EXPECT_LE( min_prim, min_n );
+
+  bool found = false;
+  for (ymuint k = 0; k < var_list.size() && !found; ++ k) {
+    const Variable& var = var_list[k];
+    if ( score(rv_mat, var) != min_n ) {
+      continue;
+    }
+    bool improved = false;
+    for (ymuint i = 0; i < bitlen && !improved; ++ i) {
+      if ( var.check_var(i) ) {
+	continue;
+      }
+      Variable var1 = var * Variable(bitlen, i);
+      bool dup = false;
+      for (ymuint k1 = 0; k1 < var_list.size(); ++ k1) {
+	if ( var_list[k1] == var1 ) {
+	  dup = true;
+	  break;
+	}
+      }
+      if ( !dup && score(rv_mat, var1) > min_n ) {
+	improved = true;
+      }
+    }
+    if ( !improved ) {
+      found = true;
+    }
+  }
+  EXPECT_TRUE( found );
+}
+
+// Shift の結果は書き換え前の実装と同じ．
+// 期待値は書き換え前の Shift_LxGen で同じ入力から求めたもの．
+TEST(LxGenTest, Shift_baseline)
+{
+  ymuint bitlen = 24;
+  ymuint n = 1000;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  vector<vector<ymuint> > expected = {
+    { 8, 13 },
+    { 11, 16, 20 },
+    { 11, 22 },
+    { 0, 7, 11 },
+    { 9, 13, 14 },
+    { 8, 12, 17 },
+    { 9, 14 },
+    { 11, 18, 22 },
+    { 8, 11 },
+    { 11, 15 },
+    { 3, 12, 22 },
+    { 7, 10, 14, 23 },
+    { 5, 8, 12 },
+    { 11, 13, 20 },
+    { 4, 13, 22 },
+    { 7, 14, 17 },
+    { 8, 11, 23 },
+    { 6, 13, 18 },
+    { 10, 11, 17, 19 },
+    { 8, 11, 13, 21 },
+    { 11, 14 },
+    { 1, 12, 15 },
+    { 2, 12, 14 },
+    { 8, 11, 19 }
+  };
+
+  ymuint thread_num_list[] = { 1, 4 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("Shift");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), bitlen, var_list);
+    delete lxgen;
+
+    ASSERT_EQ( expected.size(), var_list.size() );
+    for (ymuint i = 0; i < var_list.size(); ++ i) {
+      EXPECT_EQ( expected[i], var_list[i].vid_list() ) << i;
+    }
+  }
+}
+
+// Greedy の結果はスレッド数によらない．
+TEST(LxGenTest, Greedy_threads)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  ymuint req_num = 1000;
+  vector<Variable> var_list1;
+  vector<Variable> var_list4;
+  ymuint thread_num_list[] = { 1, 4 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("Greedy");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    lxgen->generate(rv_mgr.vect_list(), req_num,
+		    k == 0 ? var_list1 : var_list4);
+    delete lxgen;
+  }
+  ASSERT_EQ( req_num, var_list1.size() );
+  ASSERT_EQ( req_num, var_list4.size() );
+  for (ymuint i = 0; i < req_num; ++ i) {
+    EXPECT_TRUE( var_list1[i] == var_list4[i] );
+    EXPECT_LT( 0U, score(rv_mat, var_list1[i]) );
+  }
+}
+
+// 乱数を用いる生成器の結果はシード(と連鎖数)のみで決まり，スレッド数によらない．
+// 連鎖を用いる生成器が並列に動くように連鎖数を 4 にしておく．
+TEST(LxGenTest, rand_stream)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  ymuint req_num = 200;
+  const char* name_list[] = { "MCMC", "Anneal", "Tempering", "Greedy", "Simple",
+			      "Basis", "Partition" };
+  for (ymuint k = 0; k < 7; ++ k) {
+    vector<Variable> var_list[4];
+    ymuint thread_num_list[] = { 1, 4, 4, 4 };
+    ymuint64 seed_list[] = { 1, 1, 1, 2 };
+    for (ymuint j = 0; j < 4; ++ j) {
+      LxGen* lxgen = LxGen::new_obj(name_list[k]);
+      ASSERT_TRUE( lxgen != nullptr );
+      lxgen->set_thread_num(thread_num_list[j]);
+      lxgen->set_chain_num(4);
+      lxgen->set_seed(seed_list[j]);
+      lxgen->generate(rv_mgr.vect_list(), req_num, var_list[j]);
+      delete lxgen;
+    }
+    EXPECT_TRUE( var_list[0] == var_list[1] ) << name_list[k];
+    EXPECT_TRUE( var_list[1] == var_list[2] ) << name_list[k];
+    EXPECT_FALSE( var_list[1] == var_list[3] ) << name_list[k];
+  }
+}
+
+// 連鎖数が 1 の MCMC は逐次的な参照実装と同じ結果になる．
+TEST(LxGenTest, MCMC_sequential)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  ymuint req_num = 100;
+  ymuint64 seed = 3;
+  VarPool var_pool(req_num);
+  // 遷移の回数は生成する変数の数の 5 倍
+  mcmc_chain(rv_mgr.matrix(), RandStream(seed), 0, req_num * 5, var_pool);
+  ASSERT_EQ( req_num, var_pool.size() );
+
+  ymuint thread_num_list[] = { 1, 4 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("MCMC");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    lxgen->set_seed(seed);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    delete lxgen;
+
+    ASSERT_EQ( var_pool.size(), var_list.size() );
+    for (ymuint i = 0; i < var_list.size(); ++ i) {
+      EXPECT_TRUE( var_pool.var(i) == var_list[i] ) << i;
+    }
+  }
+}
+
+// 複数の連鎖の結果は連鎖番号順にまとめられ，
+// 価値の高い req_num 個の互いに異なる変数が決まった順で得られる．
+TEST(LxGenTest, MCMC_merge)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  ymuint req_num = 100;
+  ymuint chain_num = 4;
+  ymuint64 seed = 5;
+  RandStream rs(seed);
+  VarPool var_pool(req_num);
+  vector<Variable> cand_list;
+  for (ymuint cid = 0; cid < chain_num; ++ cid) {
+    VarPool pool1(req_num);
+    mcmc_chain(rv_mat, rs, cid, req_num * 5, pool1);
+    for (ymuint i = 0; i < pool1.size(); ++ i) {
+      var_pool.put(pool1.var(i), pool1.value(i));
+      cand_list.push_back(pool1.var(i));
+    }
+  }
+  ASSERT_EQ( req_num, var_pool.size() );
+
+  ymuint thread_num_list[] = { 1, 2, 4 };
+  for (ymuint k = 0; k < 3; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("MCMC");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    lxgen->set_chain_num(chain_num);
+    lxgen->set_seed(seed);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    delete lxgen;
+
+    ASSERT_EQ( req_num, var_list.size() );
+    for (ymuint i = 0; i < req_num; ++ i) {
+      EXPECT_TRUE( var_pool.var(i) == var_list[i] ) << i;
+    }
+
+    // 互いに異なり，選ばれなかった候補は選ばれたもの以下の価値しか持たない．
+    VarTable var_table;
+    ymuint64 min_score = score(rv_mat, var_list[0]);
+    for (ymuint i = 0; i < req_num; ++ i) {
+      EXPECT_EQ( i, var_table.intern(var_list[i]) );
+      ymuint64 s1 = score(rv_mat, var_list[i]);
+      if ( min_score > s1 ) {
+	min_score = s1;
+      }
+    }
+    for (ymuint i = 0; i < cand_list.size(); ++ i) {
+      if ( var_table.find(cand_list[i]) == VarTable::kNoId ) {
+	EXPECT_GE( min_score, score(rv_mat, cand_list[i]) );
+      }
+    }
+  }
+}
+
+// Anneal は既定の等比的な冷却スケジュール(0.1 から 1.0e-4)に従う．
+TEST(LxGenTest, Anneal_schedule)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  ymuint req_num = 100;
+  ymuint step_num = req_num * 5;
+  ymuint64 seed = 7;
+  double start_temp = 0.1;
+  double end_temp = 1.0e-4;
+  vector<Variable> p_list = primary_list(rv_mat);
+  RefChain chain(rv_mat, p_list, RandStream(seed), 0);
+  VarPool var_pool(req_num);
+  var_pool.put(chain.mCurVar, chain.mCurVal);
+  for (ymuint i = 0; i < step_num; ++ i) {
+    double x = static_cast<double>(i) / static_cast<double>(step_num - 1);
+    chain.move(start_temp * pow(end_temp / start_temp, x));
+    var_pool.put(chain.mCurVar, chain.mCurVal);
+  }
+
+  LxGen* lxgen = LxGen::new_obj("Anneal");
+  ASSERT_TRUE( lxgen != nullptr );
+  lxgen->set_seed(seed);
+  vector<Variable> var_list;
+  lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+  delete lxgen;
+
+  ASSERT_EQ( var_pool.size(), var_list.size() );
+  for (ymuint i = 0; i < var_list.size(); ++ i) {
+    EXPECT_TRUE( var_pool.var(i) == var_list[i] ) << i;
+  }
+}
+
+// Tempering は既定の設定(8 レプリカ，温度 1.0e-3 から 0.1，50 遷移ごとの交換)で
+// 参照実装と同じ結果を返す．結果はスレッド数によらない．
+TEST(LxGenTest, Tempering_exchange)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  ymuint req_num = 100;
+  ymuint step_num = req_num * 5;
+  ymuint64 seed = 11;
+  ymuint nr = 8;
+  ymuint interval = 50;
+  double min_temp = 1.0e-3;
+  double max_temp = 0.1;
+  RandStream rs(seed);
+  RandStream rg_exchange = rs.split(nr);
+  vector<Variable> p_list = primary_list(rv_mat);
+  vector<RefChain> chain_list;
+  vector<double> temp_list(nr);
+  vector<VarPool*> pool_list(nr);
+  for (ymuint r = 0; r < nr; ++ r) {
+    chain_list.push_back(RefChain(rv_mat, p_list, rs, r));
+    double x = static_cast<double>(r) / static_cast<double>(nr - 1);
+    temp_list[r] = min_temp * pow(max_temp / min_temp, x);
+    pool_list[r] = new VarPool(req_num);
+    pool_list[r]->put(chain_list[r].mCurVar, chain_list[r].mCurVal);
+  }
+  ymuint swap_num = 0;
+  ymuint round = 0;
+  for (ymuint done = 0; done < step_num; done += interval, ++ round) {
+    for (ymuint r = 0; r < nr; ++ r) {
+      for (ymuint i = done; i < done + interval && i < step_num; ++ i) {
+	chain_list[r].move(temp_list[r]);
+	pool_list[r]->put(chain_list[r].mCurVar, chain_list[r].mCurVal);
+      }
+    }
+    // 隣り合う温度のレプリカの状態を交換する．乱数の系列は交換しない．
+    for (ymuint r = round % 2; r + 1 < nr; r += 2) {
+      RefChain& chain1 = chain_list[r];
+      RefChain& chain2 = chain_list[r + 1];
+      double delta = (chain2.mCurVal - chain1.mCurVal) *
+	(1.0 / temp_list[r] - 1.0 / temp_list[r + 1]);
+      if ( delta < 0.0 && rg_exchange.real1() > exp(delta) ) {
+	continue;
+      }
+      std::swap(chain1.mCurVar, chain2.mCurVar);
+      std::swap(chain1.mCurVal, chain2.mCurVal);
+      ++ swap_num;
+    }
+  }
+  EXPECT_LT( 0U, swap_num );
+  VarPool var_pool(req_num);
+  for (ymuint r = 0; r < nr; ++ r) {
+    VarPool& pool1 = *pool_list[r];
+    for (ymuint i = 0; i < pool1.size(); ++ i) {
+      var_pool.put(pool1.var(i), pool1.value(i));
+    }
+    delete pool_list[r];
+  }
+
+  ymuint thread_num_list[] = { 1, 3, 8 };
+  for (ymuint k = 0; k < 3; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("Tempering");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    lxgen->set_seed(seed);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    delete lxgen;
+
+    ASSERT_EQ( var_pool.size(), var_list.size() );
+    for (ymuint i = 0; i < var_list.size(); ++ i) {
+      EXPECT_TRUE( var_pool.var(i) == var_list[i] ) << i;
+    }
+  }
+}
+
+// Simple は互いに異なる 0 でない合成変数を作る．
+TEST(LxGenTest, Simple)
+{
+  ymuint bitlen_list[] = { 10, 40, 130 };
+  for (ymuint k = 0; k < 3; ++ k) {
+    ymuint bitlen = bitlen_list[k];
+    RvMgr rv_mgr;
+    istringstream is(make_data(bitlen, 500));
+    ASSERT_TRUE( rv_mgr.read_data(is) );
+    const RvMatrix& rv_mat = rv_mgr.matrix();
+
+    // 変数によらない値を持つ入力はプライマリ変数から除かれる．
+    ymuint np = 0;
+    for (ymuint i = 0; i < bitlen; ++ i) {
+      if ( score(rv_mat, Variable(bitlen, i)) > 0 ) {
+	++ np;
+      }
+    }
+
+    ymuint req_num = 2000;
+    LxGen* lxgen = LxGen::new_obj("Simple");
+    ASSERT_TRUE( lxgen != nullptr );
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    delete lxgen;
+
+    ymuint exp_num = (np < 32 && (1U << np) - 1 < req_num) ? (1U << np) - 1 : req_num;
+    ASSERT_EQ( exp_num, var_list.size() );
+    VarTable var_table;
+    for (ymuint i = 0; i < var_list.size(); ++ i) {
+      const Variable& var = var_list[i];
+      EXPECT_EQ( bitlen, var.var_size() );
+      EXPECT_LT( 0, var.degree() );
+      EXPECT_EQ( i, var_table.intern(var) );
+    }
+  }
+}
+
+// Basis は線形独立な変数を価値の高い順に作る．
+TEST(LxGenTest, Basis)
+{
+  ymuint bitlen_list[] = { 40, 130 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    ymuint bitlen = bitlen_list[k];
+    RvMgr rv_mgr;
+    istringstream is(make_data(bitlen, 500));
+    ASSERT_TRUE( rv_mgr.read_data(is) );
+    const RvMatrix& rv_mat = rv_mgr.matrix();
+
+    ymuint np = 0;
+    double max_prim = 0.0;
+    for (ymuint i = 0; i < bitlen; ++ i) {
+      Variable var(bitlen, i);
+      if ( score(rv_mat, var) > 0 ) {
+	++ np;
+	double val = var.value(rv_mat);
+	if ( max_prim < val ) {
+	  max_prim = val;
+	}
+      }
+    }
+
+    ymuint req_list[] = { 20, 1000 };
+    for (ymuint j = 0; j < 2; ++ j) {
+      ymuint req_num = req_list[j];
+      LxGen* lxgen = LxGen::new_obj("Basis");
+      ASSERT_TRUE( lxgen != nullptr );
+      LxGenStats last_stats;
+      lxgen->set_observer([&](const LxGenStats& stats) {
+	  last_stats = stats;
+	}, 1000.0);
+      vector<Variable> var_list;
+      lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+      ymuint rank = lxgen->rank();
+      ymuint full_rank = lxgen->full_rank();
+      delete lxgen;
+
+      // 結果の数が階数となる．
+      ymuint exp_num = req_num < np ? req_num : np;
+      ASSERT_EQ( exp_num, var_list.size() );
+      EXPECT_EQ( exp_num, rank );
+      EXPECT_EQ( np, full_rank );
+      EXPECT_EQ( exp_num, last_stats.mRank );
+      EXPECT_EQ( np, last_stats.mFullRank );
+
+      BasisChecker bc;
+      EXPECT_TRUE( bc.check(var_list) );
+      EXPECT_LE( max_prim, var_list[0].value(rv_mat) );
+      for (ymuint i = 1; i < var_list.size(); ++ i) {
+	EXPECT_GE( var_list[i - 1].value(rv_mat), var_list[i].value(rv_mat) );
+      }
+
+      // 従属な変数を加えたら基底ではなくなる．
+      if ( var_list.size() < bitlen ) {
+	var_list.push_back(var_list[0] * var_list[1]);
+	EXPECT_FALSE( bc.check(var_list) );
+      }
+    }
+  }
+}
+
+// Partition は分離する対の数を増やす線形独立な変数を作る．
+TEST(LxGenTest, Partition)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  ymuint req_num = 16;
+  vector<Variable> var_list1;
+  vector<Variable> var_list4;
+  ymuint thread_num_list[] = { 1, 4 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    LxGen* lxgen = LxGen::new_obj("Partition");
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(thread_num_list[k]);
+    lxgen->generate(rv_mgr.vect_list(), req_num,
+		    k == 0 ? var_list1 : var_list4);
+    delete lxgen;
+  }
+  ASSERT_EQ( req_num, var_list1.size() );
+  ASSERT_TRUE( var_list1 == var_list4 );
+
+  BasisChecker bc;
+  EXPECT_TRUE( bc.check(var_list1) );
+  ymuint64 prev = 0;
+  for (ymuint i = 1; i <= req_num; ++ i) {
+    ymuint64 s = sep_num(rv_mat, var_list1, i);
+    EXPECT_LT( prev, s );
+    prev = s;
+  }
+
+  // 変数ごとに価値を求める Greedy より細かく分割する．
+  LxGen* lxgen = LxGen::new_obj("Greedy");
+  ASSERT_TRUE( lxgen != nullptr );
+  vector<Variable> var_list2;
+  lxgen->generate(rv_mgr.vect_list(), req_num, var_list2);
+  delete lxgen;
+  EXPECT_LE( sep_num(rv_mat, var_list2, req_num), prev );
+}
+
+// 候補の数の上限に達したらそれまでの結果を返す．
+TEST(LxGenTest, step_limit)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  ymuint req_num = 200;
+  ymuint64 limit = 1000;
+  const char* name_list[] = { "MCMC", "Anneal", "Tempering", "Greedy", "Shift",
+			      "Basis", "Partition" };
+  for (ymuint k = 0; k < 7; ++ k) {
+    LxGen* lxgen = LxGen::new_obj(name_list[k]);
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_thread_num(2);
+    lxgen->set_step_limit(limit);
+    vector<LxGenStats> stats_list;
+    lxgen->set_observer([&](const LxGenStats& stats) {
+	stats_list.push_back(stats);
+      }, 0.0);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    EXPECT_TRUE( lxgen->interrupted() ) << name_list[k];
+    delete lxgen;
+
+    EXPECT_FALSE( var_list.empty() ) << name_list[k];
+    EXPECT_GE( req_num, var_list.size() ) << name_list[k];
+    ASSERT_FALSE( stats_list.empty() ) << name_list[k];
+    const LxGenStats& last = stats_list.back();
+    EXPECT_TRUE( last.mInterrupted ) << name_list[k];
+    EXPECT_LE( limit, last.mStepNum ) << name_list[k];
+    // 連鎖ごとに 256 回までの遷移はまとめて数えるので，
+    // 最大で連鎖数(Tempering のレプリカ数 8) * 256 回程度超える．
+    EXPECT_GT( limit + 8 * 256, last.mStepNum ) << name_list[k];
+    EXPECT_LT( 0.0, last.mBestValue ) << name_list[k];
+    for (ymuint i = 1; i < stats_list.size(); ++ i) {
+      EXPECT_LE( stats_list[i - 1].mStepNum, stats_list[i].mStepNum );
+      EXPECT_LE( stats_list[i - 1].mBestValue, stats_list[i].mBestValue );
+    }
+  }
+}
+
+// 実行中に observer の中から cancel() を呼ぶと，
+// generate() はそれまでに得られた変数を返して終わる．
+TEST(LxGenTest, cancel)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  // Simple は 1024 個ごとにチェックするのでそれより大きくしておく．
+  ymuint req_num = 3000;
+  const char* name_list[] = { "MCMC", "Greedy", "Simple" };
+  for (ymuint k = 0; k < 3; ++ k) {
+    LxGen* lxgen = LxGen::new_obj(name_list[k]);
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_observer([&](const LxGenStats&) {
+	lxgen->cancel();
+      }, 0.0);
+    vector<Variable> var_list;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+    EXPECT_TRUE( lxgen->interrupted() ) << name_list[k];
+    delete lxgen;
+    EXPECT_FALSE( var_list.empty() ) << name_list[k];
+    EXPECT_GT( req_num, var_list.size() ) << name_list[k];
+  }
+}
+
+// generate() の前に呼んだ cancel() は失われずに次の generate() を打ち切り，
+// その次の generate() には持ち越されない．
+TEST(LxGenTest, cancel_before_generate)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  ymuint req_num = 3000;
+  const char* name_list[] = { "MCMC", "Greedy", "Simple" };
+  for (ymuint k = 0; k < 3; ++ k) {
+    LxGen* lxgen = LxGen::new_obj(name_list[k]);
+    ASSERT_TRUE( lxgen != nullptr );
+    lxgen->set_step_limit(100000);
+    lxgen->cancel();
+    vector<Variable> var_list1;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list1);
+    EXPECT_TRUE( lxgen->interrupted() ) << name_list[k];
+    EXPECT_GT( req_num, var_list1.size() ) << name_list[k];
+
+    vector<Variable> var_list2;
+    lxgen->generate(rv_mgr.vect_list(), req_num, var_list2);
+    EXPECT_LT( var_list1.size(), var_list2.size() ) << name_list[k];
+    delete lxgen;
+  }
+}
+
+// 上限がなければ最後まで実行する．
+TEST(LxGenTest, observer)
+{
+  ymuint bitlen = 40;
+  ymuint n = 2047;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  ymuint req_num = 100;
+  LxGen* lxgen = LxGen::new_obj("Greedy");
+  ASSERT_TRUE( lxgen != nullptr );
+  ymuint count = 0;
+  LxGenStats last;
+  lxgen->set_observer([&](const LxGenStats& stats) {
+      ++ count;
+      last = stats;
+    }, 1000.0);
+  vector<Variable> var_list;
+  lxgen->generate(rv_mgr.vect_list(), req_num, var_list);
+  EXPECT_FALSE( lxgen->interrupted() );
+  delete lxgen;
+
+  EXPECT_EQ( req_num, var_list.size() );
+  EXPECT_EQ( 1U, count );
+  EXPECT_FALSE( last.mInterrupted );
+  EXPECT_EQ( static_cast<ymuint64>(req_num) * bitlen, last.mStepNum );
+}
+
+END_NAMESPACE_YM_IGF
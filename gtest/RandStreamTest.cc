@@ -0,0 +1,88 @@
+
+/// @file RandStreamTest.cc
+/// @brief RandStreamTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "RandStream.h"
+
+
+BEGIN_NAMESPACE_YM_IGF
+
+// 同じシードからは同じ系列が得られる．
+TEST(RandStreamTest, seed)
+{
+  RandStream rs1(123);
+  RandStream rs2(123);
+  RandStream rs3(124);
+  bool diff = false;
+  for (ymuint i = 0; i < 100; ++ i) {
+    ymuint64 v1 = rs1.int64();
+    EXPECT_EQ( v1, rs2.int64() );
+    if ( v1 != rs3.int64() ) {
+      diff = true;
+    }
+  }
+  EXPECT_TRUE( diff );
+}
+
+// 派生した系列は元の系列から取り出した数によらない．
+TEST(RandStreamTest, split)
+{
+  RandStream rs1(1);
+  RandStream rs2(1);
+  for (ymuint i = 0; i < 10; ++ i) {
+    rs2.int64();
+  }
+  RandStream c1 = rs1.split(5);
+  RandStream c2 = rs2.split(5);
+  RandStream c3 = rs1.split(6);
+  bool diff = false;
+  for (ymuint i = 0; i < 100; ++ i) {
+    ymuint64 v1 = c1.int64();
+    EXPECT_EQ( v1, c2.int64() );
+    if ( v1 != c3.int64() ) {
+      diff = true;
+    }
+  }
+  EXPECT_TRUE( diff );
+}
+
+// 実数の乱数の範囲
+TEST(RandStreamTest, real)
+{
+  RandStream rs(7);
+  for (ymuint i = 0; i < 1000; ++ i) {
+    double r1 = rs.real1();
+    EXPECT_LE( 0.0, r1 );
+    EXPECT_GE( 1.0, r1 );
+    double r2 = rs.real2();
+    EXPECT_LE( 0.0, r2 );
+    EXPECT_GT( 1.0, r2 );
+  }
+}
+
+// combination は互いに異なる要素を選ぶ．
+TEST(RandStreamTest, combination)
+{
+  RandStream rs(3);
+  ymuint n = 20;
+  for (ymuint k = 0; k <= n; ++ k) {
+    vector<ymuint> elem_list;
+    rs.combination(n, k, elem_list);
+    ASSERT_EQ( k, elem_list.size() );
+    vector<bool> mark(n, false);
+    for (ymuint i = 0; i < k; ++ i) {
+      ymuint e = elem_list[i];
+      ASSERT_LT( e, n );
+      EXPECT_FALSE( mark[e] );
+      mark[e] = true;
+    }
+  }
+}
+
+END_NAMESPACE_YM_IGF
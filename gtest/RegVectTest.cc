@@ -10,10 +10,43 @@
 #include "gtest/gtest.h"
 #include "RvMgr.h"
 #include "RegVect.h"
+#include <cstdio>
 
 
 BEGIN_NAMESPACE_YM_IGF
 
+BEGIN_NONAMESPACE
+
+// テスト用の一時ファイル
+// ::testing::TempDir() の下に作り，スコープを抜けると削除する．
+class TempFile
+{
+public:
+
+  TempFile(const string& name) :
+    mName(::testing::TempDir() + name)
+  {
+  }
+
+  ~TempFile()
+  {
+    remove(mName.c_str());
+  }
+
+  const string&
+  name() const
+  {
+    return mName;
+  }
+
+private:
+
+  string mName;
+
+};
+
+END_NONAMESPACE
+
 const char* src_data[] = {
   "0001001101111000",
   "0001010000000101",
@@ -449,7 +482,8 @@ TEST(RegVectTest, read_data)
 {
   RvMgr rv_mgr;
 
-  string filename = "data1";
+  TempFile filename_tmp("data1");
+  const string& filename = filename_tmp.name();
 
   ymuint n = sizeof(src_data) / sizeof(const char*);
 
@@ -494,4 +528,347 @@ TEST(RegVectTest, read_data)
   }
 }
 
+TEST(RegVectTest, read_data_mmap)
+{
+  TempFile filename_tmp("data2");
+  const string& filename = filename_tmp.name();
+
+  ymuint n = sizeof(src_data) / sizeof(const char*);
+
+  const char* data0 = src_data[0];
+  ymuint bitlen = strlen(data0);
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << n << endl;
+    for (ymuint i = 0; i < n; ++ i) {
+      const char* data1 = src_data[i];
+      os << data1 << endl;
+    }
+  }
+
+  RvMgr rv_mgr;
+  bool stat = rv_mgr.read_data(filename);
+  EXPECT_TRUE( stat );
+
+  const vector<const RegVect*>& vlist = rv_mgr.vect_list();
+  EXPECT_EQ( n, vlist.size() );
+  EXPECT_EQ( bitlen, rv_mgr.vect_size() );
+
+  for (ymuint i = 0; i < n; ++ i) {
+    const RegVect* rv = vlist[i];
+    const char* data1 = src_data[i];
+    EXPECT_EQ( bitlen, rv->size() );
+    EXPECT_EQ( i, rv->index() );
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      ymuint val = rv->val(j);
+      if ( data1[j] == '1' ) {
+	EXPECT_EQ( 1, val );
+      }
+      else {
+	EXPECT_EQ( 0, val );
+      }
+    }
+  }
+}
+
+TEST(RegVectTest, read_data_mmap_wide)
+{
+  // SIMD の処理単位をまたぐ長さのベクタ
+  TempFile filename_tmp("data3");
+  const string& filename = filename_tmp.name();
+
+  ymuint bitlen = 150;
+  ymuint n = 50;
+  vector<string> data_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    string& data1 = data_list[i];
+    data1.resize(bitlen);
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      data1[j] = ((i * 7 + j * j) % 5 < 2) ? '1' : '0';
+    }
+    data1[i] = (data1[i] == '1') ? '0' : '1';
+  }
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << n << endl;
+    for (ymuint i = 0; i < n; ++ i) {
+      os << data_list[i] << endl;
+    }
+  }
+
+  RvMgr rv_mgr;
+  bool stat = rv_mgr.read_data(filename);
+  EXPECT_TRUE( stat );
+
+  const vector<const RegVect*>& vlist = rv_mgr.vect_list();
+  ASSERT_EQ( n, vlist.size() );
+  for (ymuint i = 0; i < n; ++ i) {
+    const RegVect* rv = vlist[i];
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      EXPECT_EQ( data_list[i][j] == '1' ? 1 : 0, rv->val(j) );
+    }
+  }
+}
+
+TEST(RegVectTest, read_data_mmap_error)
+{
+  TempFile filename_tmp("data4");
+  const string& filename = filename_tmp.name();
+
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << "40 2" << endl
+       << "0101010101010101010101010101010101010101" << endl
+       << "01010101010101010101010101010101010x0101" << endl;
+  }
+
+  RvMgr rv_mgr;
+  bool stat = rv_mgr.read_data(filename);
+  EXPECT_FALSE( stat );
+}
+
+TEST(RegVectTest, binary)
+{
+  TempFile filename_tmp("data5");
+  const string& filename = filename_tmp.name();
+  TempFile bin_filename_tmp("data5.rvb");
+  const string& bin_filename = bin_filename_tmp.name();
+
+  ymuint n = sizeof(src_data) / sizeof(const char*);
+
+  const char* data0 = src_data[0];
+  ymuint bitlen = strlen(data0);
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << n << endl;
+    for (ymuint i = 0; i < n; ++ i) {
+      const char* data1 = src_data[i];
+      os << data1 << endl;
+    }
+  }
+
+  {
+    RvMgr rv_mgr;
+    ASSERT_TRUE( rv_mgr.read_data(filename) );
+    EXPECT_TRUE( rv_mgr.write_binary(bin_filename) );
+  }
+
+  RvMgr rv_mgr;
+  bool stat = rv_mgr.map_binary(bin_filename);
+  EXPECT_TRUE( stat );
+
+  const vector<const RegVect*>& vlist = rv_mgr.vect_list();
+  EXPECT_EQ( n, vlist.size() );
+  EXPECT_EQ( bitlen, rv_mgr.vect_size() );
+
+  for (ymuint i = 0; i < n; ++ i) {
+    const RegVect* rv = vlist[i];
+    const char* data1 = src_data[i];
+    EXPECT_EQ( bitlen, rv->size() );
+    EXPECT_EQ( i, rv->index() );
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      ymuint val = rv->val(j);
+      if ( data1[j] == '1' ) {
+	EXPECT_EQ( 1, val );
+      }
+      else {
+	EXPECT_EQ( 0, val );
+      }
+    }
+  }
+
+  // テキスト形式のファイルはバイナリとしては読めない．
+  RvMgr rv_mgr2;
+  EXPECT_FALSE( rv_mgr2.map_binary(filename) );
+
+  // ベクタ数が壊れていて ベクタ数 × レコード長 が溢れるファイルも読めない．
+  // ベクタ数はヘッダの先頭から 16 バイト目にある．
+  {
+    fstream fs(bin_filename, ios::in | ios::out | ios::binary);
+    ASSERT_FALSE( fs.fail() );
+    ymuint64 bad_num = 1ULL << 63;
+    fs.seekp(16);
+    fs.write(reinterpret_cast<const char*>(&bad_num), sizeof(bad_num));
+  }
+  RvMgr rv_mgr3;
+  EXPECT_FALSE( rv_mgr3.map_binary(bin_filename) );
+
+  // 失敗しても状態は変わらないので同じオブジェクトで読み直せる．
+  ASSERT_TRUE( rv_mgr3.read_data(filename) );
+  EXPECT_EQ( n, rv_mgr3.vect_list().size() );
+
+  // レコードのインデックスが範囲外のファイルも読めない．
+  // 最初のレコードはヘッダ(32 バイト)の直後にあり，
+  // インデックスはその 4 バイト目にある．
+  TempFile bin_filename2_tmp("data5b.rvb");
+  const string& bin_filename2 = bin_filename2_tmp.name();
+  EXPECT_TRUE( rv_mgr3.write_binary(bin_filename2) );
+  {
+    fstream fs(bin_filename2, ios::in | ios::out | ios::binary);
+    ASSERT_FALSE( fs.fail() );
+    ymuint32 bad_index = n;
+    fs.seekp(32 + 4);
+    fs.write(reinterpret_cast<const char*>(&bad_index), sizeof(bad_index));
+  }
+  RvMgr rv_mgr4;
+  EXPECT_FALSE( rv_mgr4.map_binary(bin_filename2) );
+
+  // ヘッダより短いファイルも読めない．
+  {
+    ofstream os(bin_filename2, ios::binary);
+    os.write("rvb", 3);
+  }
+  RvMgr rv_mgr5;
+  EXPECT_FALSE( rv_mgr5.map_binary(bin_filename2) );
+}
+
+TEST(RegVectTest, read_data_mt)
+{
+  TempFile filename_tmp("data6");
+  const string& filename = filename_tmp.name();
+
+  // 重複を含むデータを作る．
+  ymuint n = sizeof(src_data) / sizeof(const char*);
+  vector<ymuint> id_list;
+  for (ymuint i = 0; i < n; ++ i) {
+    id_list.push_back(i);
+    if ( i % 3 == 0 ) {
+      id_list.push_back(i / 2);
+    }
+  }
+  ymuint nl = id_list.size();
+
+  const char* data0 = src_data[0];
+  ymuint bitlen = strlen(data0);
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << nl << endl;
+    for (ymuint i = 0; i < nl; ++ i) {
+      os << src_data[id_list[i]] << endl;
+    }
+  }
+
+  for (ymuint nt = 1; nt <= 8; ++ nt) {
+    RvMgr rv_mgr;
+    bool stat = rv_mgr.read_data(filename, nt);
+    EXPECT_TRUE( stat );
+
+    // 出現順に重複が取り除かれている．
+    const vector<const RegVect*>& vlist = rv_mgr.vect_list();
+    ASSERT_EQ( n, vlist.size() );
+    for (ymuint i = 0; i < n; ++ i) {
+      const RegVect* rv = vlist[i];
+      const char* data1 = src_data[i];
+      EXPECT_EQ( i, rv->index() );
+      for (ymuint j = 0; j < bitlen; ++ j) {
+	EXPECT_EQ( data1[j] == '1' ? 1 : 0, rv->val(j) );
+      }
+    }
+  }
+
+  // エラー行はスレッド数によらず検出される．
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << n << endl;
+    for (ymuint i = 0; i < n; ++ i) {
+      if ( i == n - 2 ) {
+	os << "0" << endl;
+      }
+      else {
+	os << src_data[i] << endl;
+      }
+    }
+  }
+  for (ymuint nt = 1; nt <= 8; ++ nt) {
+    RvMgr rv_mgr;
+    EXPECT_FALSE( rv_mgr.read_data(filename, nt) );
+  }
+}
+
+TEST(RegVectTest, hash)
+{
+  // 1ビットだけ異なるベクタはハッシュ値も異なる．
+  ymuint bitlen = 200;
+  ostringstream os;
+  os << bitlen << " " << (bitlen + 2) << endl;
+  for (ymuint i = 0; i <= bitlen; ++ i) {
+    string data1(bitlen, '0');
+    if ( i < bitlen ) {
+      data1[i] = '1';
+    }
+    os << data1 << endl;
+  }
+  // 重複データ
+  os << string(bitlen, '0') << endl;
+
+  RvMgr rv_mgr;
+  istringstream is(os.str());
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const vector<const RegVect*>& vlist = rv_mgr.vect_list();
+  ASSERT_EQ( bitlen + 1, vlist.size() );
+  for (ymuint i = 0; i < vlist.size(); ++ i) {
+    for (ymuint j = i + 1; j < vlist.size(); ++ j) {
+      EXPECT_NE( vlist[i]->hash(), vlist[j]->hash() );
+    }
+  }
+
+  // 平均プローブ長は小さい．
+  ostringstream os2;
+  rv_mgr.print_hash_stats(os2);
+  istringstream is2(os2.str());
+  string buf;
+  getline(is2, buf);
+  EXPECT_EQ( "# of lookups:         " + to_string(bitlen + 2), buf );
+  getline(is2, buf);
+  double ave = atof(buf.substr(buf.find(':') + 1).c_str());
+  EXPECT_GE( 1.5, ave );
+}
+
+// シャードが多くても重複は正しく取り除かれ，平均プローブ長は小さい．
+TEST(RegVectTest, hash_shard)
+{
+  TempFile filename_tmp("data7");
+  const string& filename = filename_tmp.name();
+
+  ymuint bitlen = 64;
+  ymuint n = 20000;
+  ymuint nl = n + n / 4;
+  {
+    ofstream os(filename);
+    ASSERT_FALSE( os.fail() );
+    os << bitlen << " " << nl << endl;
+    for (ymuint i = 0; i < nl; ++ i) {
+      // 後ろの n / 4 行は前の行の重複
+      ymuint64 x = (i < n ? i : (i - n) * 3) * 0x9E3779B97F4A7C15ULL + 1ULL;
+      for (ymuint j = 0; j < bitlen; ++ j) {
+	os << ((x >> j) & 1ULL ? '1' : '0');
+      }
+      os << endl;
+    }
+  }
+
+  ymuint nt_list[] = { 1, 16 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    RvMgr rv_mgr;
+    ASSERT_TRUE( rv_mgr.read_data(filename, nt_list[k]) );
+    EXPECT_EQ( n, rv_mgr.vect_list().size() );
+
+    ostringstream os2;
+    rv_mgr.print_hash_stats(os2);
+    istringstream is2(os2.str());
+    string buf;
+    getline(is2, buf);
+    EXPECT_EQ( "# of lookups:         " + to_string(nl), buf );
+    getline(is2, buf);
+    double ave = atof(buf.substr(buf.find(':') + 1).c_str());
+    EXPECT_GE( 2.0, ave ) << "thread_num = " << nt_list[k];
+  }
+}
+
 END_NAMESPACE_YM_IGF
@@ -0,0 +1,437 @@
+
+/// @file RvMatrixTest.cc
+/// @brief RvMatrixTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "RvMatrix.h"
+#include "RvMgr.h"
+#include "RegVect.h"
+#include "Variable.h"
+#include "SparseVariable.h"
+#include "SigFunc.h"
+
+
+BEGIN_NAMESPACE_YM_IGF
+
+BEGIN_NONAMESPACE
+
+// テスト用のデータを作る．
+string
+make_data(ymuint bitlen,
+	  ymuint n)
+{
+  ostringstream os;
+  os << bitlen << " " << n << endl;
+  for (ymuint i = 0; i < n; ++ i) {
+    ymuint64 x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      x ^= (x << 13);
+      x ^= (x >> 7);
+      x ^= (x << 17);
+      os << ((x & 1ULL) ? '1' : '0');
+    }
+    os << endl;
+  }
+  return os.str();
+}
+
+END_NONAMESPACE
+
+TEST(RvMatrixTest, set)
+{
+  ymuint bitlen = 130;
+  ymuint n = 200;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  const vector<const RegVect*>& rv_list = rv_mgr.vect_list();
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  EXPECT_EQ( bitlen, rv_mat.vect_size() );
+  EXPECT_EQ( rv_list.size(), rv_mat.vect_num() );
+  EXPECT_EQ( 3, rv_mat.block_size() );
+  EXPECT_EQ( 0, reinterpret_cast<ymuint64>(rv_mat.row(0)) % 64 );
+  for (ymuint i = 0; i < rv_list.size(); ++ i) {
+    const RegVect* rv = rv_list[i];
+    EXPECT_EQ( rv->index(), rv_mat.index(i) );
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      EXPECT_EQ( rv->val(j), rv_mat.val(i, j) );
+    }
+  }
+}
+
+TEST(RvMatrixTest, classify)
+{
+  ymuint bitlen = 100;
+  ymuint n = 300;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  const vector<const RegVect*>& rv_list = rv_mgr.vect_list();
+  RvMatrix rv_mat(rv_list);
+  for (ymuint i = 0; i < bitlen; ++ i) {
+    Variable var(bitlen, i);
+    var *= Variable(bitlen, (i * 7 + 3) % bitlen);
+    var *= Variable(bitlen, (i * 13 + 71) % bitlen);
+    ymuint64 n1 = 0;
+    for (ymuint j = 0; j < rv_list.size(); ++ j) {
+      ymuint c = rv_list[j]->classify(var);
+      EXPECT_EQ( c, rv_mat.classify(j, var) );
+      n1 += c;
+    }
+    EXPECT_EQ( n1, rv_mat.count1(var) );
+    EXPECT_EQ( var.value(rv_list), var.value(rv_mat) );
+  }
+}
+
+TEST(RvMatrixTest, classify_all)
+{
+  // 列のブロックの境界をまたぐようにベクタ数を選ぶ．
+  ymuint bitlen = 70;
+  ymuint n = 64 * 70 + 5;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  ymuint nv = rv_mat.vect_num();
+  EXPECT_EQ( (nv + 63) / 64, rv_mat.column_size() );
+  for (ymuint j = 0; j < bitlen; ++ j) {
+    const ymuint64* col = rv_mat.column(j);
+    for (ymuint i = 0; i < nv; ++ i) {
+      EXPECT_EQ( rv_mat.val(i, j), (col[i / 64] >> (i % 64)) & 1ULL );
+    }
+  }
+
+  for (ymuint k = 0; k < 20; ++ k) {
+    Variable var(bitlen, k);
+    var *= Variable(bitlen, (k * 11 + 5) % bitlen);
+    var *= Variable(bitlen, (k * 3 + 64) % bitlen);
+    vector<ymuint64> bits = rv_mat.classify_all(var);
+    ASSERT_EQ( rv_mat.column_size(), bits.size() );
+    ymuint64 n1 = 0;
+    for (ymuint i = 0; i < nv; ++ i) {
+      ymuint c = (bits[i / 64] >> (i % 64)) & 1ULL;
+      EXPECT_EQ( rv_mat.classify(i, var), c );
+      n1 += c;
+    }
+    // 余りのビットは 0
+    EXPECT_EQ( n1, RvMatrix::count_bits(&bits[0], bits.size()) );
+    EXPECT_EQ( n1, rv_mat.count1(var) );
+
+    // RvMgr::value(var1, var2) は行ごとの分類と一致する．
+    Variable var2(bitlen, (k * 5 + 1) % bitlen);
+    ymuint64 cnt[4] = { 0, 0, 0, 0 };
+    for (ymuint i = 0; i < nv; ++ i) {
+      ++ cnt[rv_mat.classify(i, var) * 2 + rv_mat.classify(i, var2)];
+    }
+    ymuint64 n_ideal = (static_cast<ymuint64>(nv) * nv * 6) / 16;
+    ymuint64 np = cnt[0] * (cnt[1] + cnt[2] + cnt[3]) + cnt[1] * (cnt[2] + cnt[3]) + cnt[2] * cnt[3];
+    EXPECT_EQ( static_cast<double>(np) / static_cast<double>(n_ideal),
+	       rv_mgr.value(var, var2) );
+  }
+}
+
+TEST(RvMatrixTest, classify_rows)
+{
+  // 使用可能なすべてのカーネルがスカラー版と同じ結果を返す．
+  // ブロック数を固定した特殊化版(1, 2 ブロック)と汎用版を試す．
+  ymuint bitlen_list[] = { 40, 128, 150 };
+  for (ymuint l = 0; l < 3; ++ l) {
+    ymuint bitlen = bitlen_list[l];
+    ymuint n = 333;
+    RvMgr rv_mgr;
+    istringstream is(make_data(bitlen, n));
+    ASSERT_TRUE( rv_mgr.read_data(is) );
+    const RvMatrix& rv_mat = rv_mgr.matrix();
+    ymuint nv = rv_mat.vect_num();
+
+    const char* name_list[] = { "avx512", "avx2", "popcnt", "scalar" };
+    for (ymuint k = 0; k < 4; ++ k) {
+      if ( !RvMatrix::select_kernel(name_list[k]) ) {
+	continue;
+      }
+      EXPECT_EQ( string(name_list[k]), string(RvMatrix::kernel_name()) );
+      for (ymuint v = 0; v < 10; ++ v) {
+	Variable var(bitlen, (v * 13) % bitlen);
+	var *= Variable(bitlen, (v * 29 + 70) % bitlen);
+	var *= Variable(bitlen, (v * 7 + 140) % bitlen);
+	// 先頭と長さを変えて端数の処理を確かめる．
+	ymuint pos_list[] = { 0, 1, 7, 64 };
+	for (ymuint p = 0; p < 4; ++ p) {
+	  ymuint pos = pos_list[p];
+	  ymuint num = nv - pos - v;
+	  vector<ymuint64> bits((num + 63) / 64, ~0ULL);
+	  rv_mat.classify_rows(var, pos, num, &bits[0]);
+	  for (ymuint i = 0; i < bits.size() * 64; ++ i) {
+	    ymuint c = (bits[i / 64] >> (i % 64)) & 1ULL;
+	    if ( i < num ) {
+	      EXPECT_EQ( rv_mat.classify(pos + i, var), c );
+	    }
+	    else {
+	      EXPECT_EQ( 0, c );
+	    }
+	  }
+	}
+	ymuint64 n1 = 0;
+	for (ymuint i = 0; i < nv; ++ i) {
+	  n1 += rv_mat.classify(i, var);
+	}
+	EXPECT_EQ( n1, rv_mat.count1(var) );
+      }
+    }
+  }
+  EXPECT_TRUE( RvMatrix::select_kernel(string()) );
+  EXPECT_FALSE( RvMatrix::select_kernel("xyz") );
+}
+
+TEST(RvMatrixTest, dense_rows)
+{
+  // 次数の高い変数は行ごとの分類で数える．
+  // 使用可能なすべてのカーネルと，ブロック数を固定した特殊化版(2 ブロック)
+  // および汎用版で，行ごとに分類した結果と一致する．
+  // 1 ブロックでは列の XOR が常に選ばれるので RvStreamTest で確かめる．
+  ymuint bitlen_list[] = { 128, 200 };
+  for (ymuint l = 0; l < 2; ++ l) {
+    ymuint bitlen = bitlen_list[l];
+    ymuint n = 64 * 3 + 17;
+    RvMgr rv_mgr;
+    istringstream is(make_data(bitlen, n));
+    ASSERT_TRUE( rv_mgr.read_data(is) );
+    const RvMatrix& rv_mat = rv_mgr.matrix();
+    ymuint nv = rv_mat.vect_num();
+    ymuint nb = rv_mat.column_size();
+
+    // ほぼすべてのビットを含む変数を作る．
+    vector<Variable> var_list;
+    for (ymuint v = 0; v < 3; ++ v) {
+      Variable var(bitlen, v);
+      for (ymuint i = 0; i < bitlen; ++ i) {
+	if ( i != v && (i % 7) != v ) {
+	  var *= Variable(bitlen, i);
+	}
+      }
+      ASSERT_FALSE( SparseVariable::is_preferred_column(var) );
+      var_list.push_back(var);
+    }
+    Variable var0(bitlen, 5);
+    vector<ymuint64> bits0 = rv_mat.classify_all(var0);
+
+    const char* name_list[] = { "avx512", "avx2", "popcnt", "scalar" };
+    for (ymuint k = 0; k < 4; ++ k) {
+      if ( !RvMatrix::select_kernel(name_list[k]) ) {
+	continue;
+      }
+      vector<ymuint64> exp_hist(1U << var_list.size(), 0);
+      vector<ymuint64> exp_n1(var_list.size(), 0);
+      ymuint64 exp_x1 = 0;
+      for (ymuint i = 0; i < nv; ++ i) {
+	ymuint p = 0;
+	for (ymuint v = 0; v < var_list.size(); ++ v) {
+	  ymuint c = rv_mat.classify(i, var_list[v]);
+	  exp_n1[v] += c;
+	  p |= c << v;
+	}
+	++ exp_hist[p];
+	exp_x1 += rv_mat.classify(i, var_list[0] * var0);
+      }
+      for (ymuint v = 0; v < var_list.size(); ++ v) {
+	EXPECT_EQ( exp_n1[v], rv_mat.count1(var_list[v]) );
+      }
+      vector<ymuint64> hist;
+      rv_mat.joint_count(var_list, hist);
+      EXPECT_EQ( exp_hist, hist );
+
+      vector<ymuint64> bits1(nb);
+      EXPECT_EQ( exp_x1, rv_mat.xor_classify(var_list[0], &bits0[0], &bits1[0]) );
+      EXPECT_EQ( rv_mat.classify_all(var_list[0] * var0), bits1 );
+
+      // 次数の低い変数との合成は列の XOR で求める．
+      EXPECT_EQ( rv_mat.count1(var0 * Variable(bitlen, 9)),
+		 rv_mat.xor_classify(Variable(bitlen, 9), &bits0[0], &bits1[0]) );
+    }
+  }
+  EXPECT_TRUE( RvMatrix::select_kernel(string()) );
+}
+
+TEST(RvMatrixTest, count1_list)
+{
+  ymuint bitlen = 90;
+  ymuint n = 64 * 64 * 2 + 100;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+
+  vector<Variable> var_list;
+  for (ymuint i = 0; i < 40; ++ i) {
+    Variable var(bitlen, i);
+    for (ymuint j = 1; j < i % 5; ++ j) {
+      var *= Variable(bitlen, (i + j * 17) % bitlen);
+    }
+    var_list.push_back(var);
+  }
+  vector<ymuint64> n1_list;
+  rv_mat.count1(var_list, n1_list);
+  ASSERT_EQ( var_list.size(), n1_list.size() );
+  for (ymuint i = 0; i < var_list.size(); ++ i) {
+    EXPECT_EQ( rv_mat.count1(var_list[i]), n1_list[i] );
+  }
+
+  rv_mat.count1(vector<Variable>(), n1_list);
+  EXPECT_TRUE( n1_list.empty() );
+}
+
+TEST(RvMatrixTest, xor_bits)
+{
+  // 分類結果の XOR が合成変数の分類結果と一致する．
+  ymuint bitlen = 80;
+  ymuint n = 64 * 9 + 33;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  ymuint nb = rv_mat.column_size();
+
+  const char* name_list[] = { "avx512", "avx2", "popcnt", "scalar" };
+  for (ymuint k = 0; k < 4; ++ k) {
+    if ( !RvMatrix::select_kernel(name_list[k]) ) {
+      continue;
+    }
+    Variable var1(bitlen, 0);
+    vector<ymuint64> bits1 = rv_mat.classify_all(var1);
+    for (ymuint i = 1; i < 20; ++ i) {
+      Variable var2(bitlen, (i * 37) % bitlen);
+      var2 *= Variable(bitlen, (i * 11 + 3) % bitlen);
+      vector<ymuint64> bits2 = rv_mat.classify_all(var2);
+      vector<ymuint64> bits3(nb);
+      ymuint64 n1 = RvMatrix::xor_bits(&bits1[0], &bits2[0], &bits3[0], nb);
+      var1 *= var2;
+      EXPECT_EQ( rv_mat.classify_all(var1), bits3 );
+      EXPECT_EQ( rv_mat.count1(var1), n1 );
+
+      // 結果を入力に上書きしてもよい．
+      EXPECT_EQ( n1, RvMatrix::xor_bits(&bits1[0], &bits2[0], &bits1[0], nb) );
+      EXPECT_EQ( bits3, bits1 );
+    }
+  }
+  EXPECT_TRUE( RvMatrix::select_kernel(string()) );
+}
+
+TEST(RvMatrixTest, joint_count)
+{
+  // 行ごとに数えた結果と一致する．
+  ymuint bitlen = 75;
+  ymuint n = 64 * 5 + 21;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  ymuint nv = rv_mat.vect_num();
+
+  const char* name_list[] = { "avx512", "avx2", "popcnt", "scalar" };
+  for (ymuint k = 0; k < 4; ++ k) {
+    if ( !RvMatrix::select_kernel(name_list[k]) ) {
+      continue;
+    }
+    vector<Variable> var_list;
+    for (ymuint t = 0; t <= 5; ++ t) {
+      vector<ymuint64> hist;
+      rv_mat.joint_count(var_list, hist);
+      ASSERT_EQ( 1U << t, hist.size() );
+      vector<ymuint64> exp_hist(1U << t, 0);
+      for (ymuint i = 0; i < nv; ++ i) {
+	ymuint p = 0;
+	for (ymuint v = 0; v < t; ++ v) {
+	  p |= rv_mat.classify(i, var_list[v]) << v;
+	}
+	++ exp_hist[p];
+      }
+      EXPECT_EQ( exp_hist, hist );
+
+      Variable var(bitlen, (t * 23) % bitlen);
+      var *= Variable(bitlen, (t * 41 + 7) % bitlen);
+      var_list.push_back(var);
+    }
+  }
+  EXPECT_TRUE( RvMatrix::select_kernel(string()) );
+
+  // 1変数の場合は Variable::value() と同じ
+  vector<Variable> var_list1(1, Variable(bitlen, 3));
+  EXPECT_EQ( rv_mgr.value(var_list1[0]), rv_mgr.value(var_list1) );
+
+  // 2変数の場合は各組み合わせの数から求めた値と同じ
+  Variable var1(bitlen, 5);
+  Variable var2(bitlen, 9);
+  var2 *= Variable(bitlen, 70);
+  ymuint64 c[4] = { 0, 0, 0, 0 };
+  for (ymuint i = 0; i < nv; ++ i) {
+    ++ c[rv_mat.classify(i, var1) + rv_mat.classify(i, var2) * 2];
+  }
+  ymuint64 n2 = c[0] * (c[1] + c[2] + c[3]) + c[1] * (c[2] + c[3]) + c[2] * c[3];
+  ymuint64 n_ideal = (static_cast<ymuint64>(nv) * nv * 6) / 16;
+  EXPECT_EQ( static_cast<double>(n2) / static_cast<double>(n_ideal),
+	     rv_mgr.value(var1, var2) );
+}
+
+TEST(RvMatrixTest, sparse)
+{
+  // 疎な表現による分類は密な表現と一致する．
+  ymuint bitlen = 520;
+  ymuint n = 64 * 3 + 17;
+  RvMgr rv_mgr;
+  istringstream is(make_data(bitlen, n));
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const vector<const RegVect*>& rv_list = rv_mgr.vect_list();
+  const RvMatrix& rv_mat = rv_mgr.matrix();
+  ymuint nv = rv_mat.vect_num();
+
+  vector<Variable> var_list;
+  for (ymuint k = 0; k < 8; ++ k) {
+    Variable var(bitlen, (k * 67) % bitlen);
+    for (ymuint j = 0; j < k; ++ j) {
+      var *= Variable(bitlen, (k * 31 + j * 101 + 1) % bitlen);
+    }
+    var_list.push_back(var);
+
+    SparseVariable svar = var;
+    vector<ymuint64> bits(rv_mat.column_size(), ~0ULL);
+    rv_mat.classify_all(svar, &bits[0]);
+    EXPECT_EQ( rv_mat.classify_all(var), bits );
+    for (ymuint i = 0; i < nv; ++ i) {
+      EXPECT_EQ( rv_mat.classify(i, var), rv_mat.classify(i, svar) );
+      EXPECT_EQ( rv_list[i]->classify(var), rv_list[i]->classify(svar) );
+    }
+  }
+
+  // SigFunc は出力ごとに表現を選ぶ．
+  SigFunc sf(var_list);
+  vector<ymuint> val_list;
+  sf.eval_all(rv_mat, val_list);
+  for (ymuint i = 0; i < nv; ++ i) {
+    ymuint exp_val = 0;
+    for (ymuint k = 0; k < var_list.size(); ++ k) {
+      exp_val |= rv_list[i]->classify(var_list[k]) << k;
+    }
+    EXPECT_EQ( exp_val, val_list[i] );
+    EXPECT_EQ( exp_val, sf.eval(rv_list[i]) );
+    EXPECT_EQ( exp_val, sf.eval(rv_mat, i) );
+  }
+}
+
+TEST(RvMatrixTest, empty)
+{
+  RvMatrix rv_mat;
+  EXPECT_EQ( 0, rv_mat.vect_num() );
+  rv_mat.set(vector<const RegVect*>());
+  EXPECT_EQ( 0, rv_mat.vect_num() );
+  EXPECT_EQ( 0, rv_mat.vect_size() );
+}
+
+END_NAMESPACE_YM_IGF
@@ -0,0 +1,223 @@
+
+/// @file RvStreamTest.cc
+/// @brief RvStreamTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "RvStream.h"
+#include "RvMgr.h"
+#include "RegVect.h"
+#include "Variable.h"
+#include <cstdio>
+#include <sys/resource.h>
+
+
+BEGIN_NAMESPACE_YM_IGF
+
+BEGIN_NONAMESPACE
+
+// テスト用のデータを作る．
+// 重複したデータを含む．
+string
+make_data(ymuint bitlen,
+	  ymuint n,
+	  vector<string>& uniq_list)
+{
+  ostringstream os;
+  os << bitlen << " " << (n + n / 4) << endl;
+  uniq_list.clear();
+  for (ymuint i = 0; i < n; ++ i) {
+    string data1(bitlen, '0');
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      if ( ((i * 2654435761U) >> (j % 32)) & 1U ) {
+	data1[j] = '1';
+      }
+    }
+    for (ymuint j = 0; j < bitlen && j < 32; ++ j) {
+      data1[bitlen - 1 - j] = ((i >> j) & 1U) ? '1' : '0';
+    }
+    uniq_list.push_back(data1);
+    os << data1 << endl;
+    if ( i % 4 == 3 ) {
+      // 少し前のデータを繰り返す．
+      os << uniq_list[i / 2] << endl;
+    }
+  }
+  return os.str();
+}
+
+// テスト用の一時ファイル
+// ::testing::TempDir() の下に作り，スコープを抜けると削除する．
+class TempFile
+{
+public:
+
+  TempFile(const string& name) :
+    mName(::testing::TempDir() + name)
+  {
+  }
+
+  ~TempFile()
+  {
+    remove(mName.c_str());
+  }
+
+  const string&
+  name() const
+  {
+    return mName;
+  }
+
+private:
+
+  string mName;
+
+};
+
+END_NONAMESPACE
+
+TEST(RvStreamTest, read_data)
+{
+  ymuint bitlen = 70;
+  ymuint n = 1000;
+  vector<string> uniq_list;
+  string data = make_data(bitlen, n, uniq_list);
+
+  // チャンクサイズを変えても結果は同じ
+  ymuint chunk_list[] = { 1, 7, 64, 1000, 5000 };
+  for (ymuint c = 0; c < 5; ++ c) {
+    RvStream rs(chunk_list[c]);
+    istringstream is(data);
+    EXPECT_TRUE( rs.read_data(is) );
+    EXPECT_EQ( bitlen, rs.vect_size() );
+    EXPECT_EQ( n, rs.vect_num() );
+    EXPECT_EQ( 10, rs.index_size() );
+
+    ymuint id = 0;
+    for (rs.rewind(); rs.next_chunk(); ) {
+      const vector<const RegVect*>& rv_list = rs.chunk();
+      EXPECT_GE( chunk_list[c], rv_list.size() );
+      for (ymuint i = 0; i < rv_list.size(); ++ i, ++ id) {
+	const RegVect* rv = rv_list[i];
+	EXPECT_EQ( id, rv->index() );
+	const string& data1 = uniq_list[id];
+	for (ymuint j = 0; j < bitlen; ++ j) {
+	  EXPECT_EQ( data1[j] == '1' ? 1 : 0, rv->val(j) );
+	}
+      }
+    }
+    EXPECT_EQ( n, id );
+  }
+}
+
+TEST(RvStreamTest, value)
+{
+  ymuint bitlen = 40;
+  ymuint n = 500;
+  vector<string> uniq_list;
+  string data = make_data(bitlen, n, uniq_list);
+
+  TempFile filename_tmp("rvstream.rvb");
+  const string& filename = filename_tmp.name();
+  RvMgr rv_mgr;
+  {
+    istringstream is(data);
+    ASSERT_TRUE( rv_mgr.read_data(is) );
+    ASSERT_TRUE( rv_mgr.write_binary(filename) );
+  }
+
+  RvStream rs(33);
+  ASSERT_TRUE( rs.open_binary(filename) );
+  EXPECT_EQ( rv_mgr.vect_list().size(), rs.vect_num() );
+
+  for (ymuint i = 0; i < bitlen; ++ i) {
+    Variable var(bitlen, i);
+    if ( i > 0 ) {
+      var *= Variable(bitlen, i - 1);
+    }
+    EXPECT_EQ( rv_mgr.value(var), rs.value(var) );
+  }
+
+  // 走査の途中で value() を呼んでも走査は続けられる．
+  Variable var0(bitlen, 0);
+  ymuint id = 0;
+  for (rs.rewind(); rs.next_chunk(); ) {
+    const vector<const RegVect*>& rv_list = rs.chunk();
+    ASSERT_FALSE( rv_list.empty() );
+    EXPECT_EQ( id, rv_list[0]->index() );
+    id += rv_list.size();
+    EXPECT_EQ( rv_mgr.value(var0), rs.value(var0) );
+    EXPECT_EQ( id - rv_list.size(), rv_list[0]->index() );
+  }
+  EXPECT_EQ( rs.vect_num(), id );
+
+  // ベクタ数がファイルの長さを超えるヘッダは受け付けない．
+  {
+    FILE* fp = fopen(filename.c_str(), "r+b");
+    ASSERT_TRUE( fp != nullptr );
+    ymuint64 bad_num = rs.vect_num() + 1;
+    fseek(fp, 16, SEEK_SET);
+    fwrite(&bad_num, sizeof(bad_num), 1, fp);
+    fclose(fp);
+  }
+  EXPECT_FALSE( rs.open_binary(filename) );
+  EXPECT_EQ( 0, rs.vect_num() );
+}
+
+// ラン数が同時に開けるファイル数を超えても読み込める．
+TEST(RvStreamTest, many_runs)
+{
+  ymuint bitlen = 20;
+  ymuint n = 3000;
+  vector<string> uniq_list;
+  string data = make_data(bitlen, n, uniq_list);
+
+  struct rlimit old_lim;
+  ASSERT_EQ( 0, getrlimit(RLIMIT_NOFILE, &old_lim) );
+  struct rlimit new_lim = old_lim;
+  if ( new_lim.rlim_cur == RLIM_INFINITY || new_lim.rlim_cur > 256 ) {
+    new_lim.rlim_cur = 256;
+  }
+  ASSERT_EQ( 0, setrlimit(RLIMIT_NOFILE, &new_lim) );
+
+  RvStream rs(1);
+  istringstream is(data);
+  bool stat = rs.read_data(is);
+
+  setrlimit(RLIMIT_NOFILE, &old_lim);
+
+  ASSERT_TRUE( stat );
+  EXPECT_EQ( n, rs.vect_num() );
+  ymuint id = 0;
+  for (rs.rewind(); rs.next_chunk(); ) {
+    const vector<const RegVect*>& rv_list = rs.chunk();
+    for (ymuint i = 0; i < rv_list.size(); ++ i, ++ id) {
+      const RegVect* rv = rv_list[i];
+      EXPECT_EQ( id, rv->index() );
+      const string& data1 = uniq_list[id];
+      for (ymuint j = 0; j < bitlen; ++ j) {
+	EXPECT_EQ( data1[j] == '1' ? 1 : 0, rv->val(j) );
+      }
+    }
+  }
+  EXPECT_EQ( n, id );
+}
+
+TEST(RvStreamTest, error)
+{
+  istringstream is("20 3\n"
+		   "01010101010101010101\n"
+		   "0101010101010101010\n"
+		   "01010101010101010101\n");
+  RvStream rs(1);
+  EXPECT_FALSE( rs.read_data(is) );
+  EXPECT_EQ( 0, rs.vect_num() );
+  rs.rewind();
+  EXPECT_FALSE( rs.next_chunk() );
+}
+
+END_NAMESPACE_YM_IGF
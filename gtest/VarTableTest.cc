@@ -0,0 +1,259 @@
+
+/// @file VarTableTest.cc
+/// @brief VarTableTest の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "gtest/gtest.h"
+#include "VarTable.h"
+#include "VarPool.h"
+#include <algorithm>
+#include "Variable.h"
+#include "SigFunc.h"
+#include "RvMgr.h"
+#include "RvMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_IGF
+
+// 登録と検索のテスト
+TEST(VarTableTest, intern)
+{
+  // 内部の領域に収まる場合とヒープを用いる場合
+  ymuint n_list[] = { 40, Variable::kInlineSize + 70 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    ymuint n = n_list[k];
+    VarTable var_table;
+    EXPECT_EQ( 0, var_table.num() );
+
+    // ハッシュ表の拡張が起こるくらいの数を登録する．
+    vector<Variable> var_list;
+    vector<ymuint> id_list;
+    for (ymuint i = 0; i < n; ++ i) {
+      for (ymuint j = i; j < n; j += 3) {
+	Variable var(n, i);
+	if ( j != i ) {
+	  var *= Variable(n, j);
+	}
+	ymuint id = var_table.intern(var);
+	EXPECT_EQ( var_list.size(), id );
+	var_list.push_back(var);
+	id_list.push_back(id);
+      }
+    }
+    EXPECT_EQ( n, var_table.var_size() );
+    EXPECT_EQ( var_list.size(), var_table.num() );
+
+    // 同じ内容なら同じ番号になる．
+    for (ymuint i = 0; i < var_list.size(); ++ i) {
+      Variable var(var_list[i]);
+      EXPECT_EQ( id_list[i], var_table.intern(var) );
+      EXPECT_EQ( id_list[i], var_table.find(var) );
+      EXPECT_TRUE( var_list[i] == var_table.var(id_list[i]) );
+    }
+    EXPECT_EQ( var_list.size(), var_table.num() );
+
+    // 合成演算
+    ymuint id1 = var_table.find(Variable(n, 0));
+    ymuint id2 = var_table.find(Variable(n, 1));
+    ymuint id3 = var_table.compose(id1, id2);
+    EXPECT_TRUE( var_table.var(id3) == Variable(n, 0) * Variable(n, 1) );
+    EXPECT_EQ( id1, var_table.compose(id3, id2) );
+
+    // 登録されていない変数
+    Variable var(n, 0);
+    var *= Variable(n, 1);
+    var *= Variable(n, 2);
+    EXPECT_EQ( VarTable::kNoId, var_table.find(var) );
+    EXPECT_EQ( VarTable::kNoId, var_table.find(Variable(n + 1, 0)) );
+
+    var_table.clear();
+    EXPECT_EQ( 0, var_table.num() );
+    EXPECT_EQ( VarTable::kNoId, var_table.find(Variable(n, 0)) );
+  }
+}
+
+// VarPool の重複チェックのテスト
+// ムーブは本体の領域をそのまま引き継ぐ．
+TEST(VarTableTest, move)
+{
+  ymuint bitlen = 100;
+  VarTable var_table;
+  for (ymuint i = 0; i < bitlen; ++ i) {
+    var_table.intern(Variable(bitlen, i));
+  }
+  const ymuint64* body = var_table.body(0);
+
+  VarTable var_table2(std::move(var_table));
+  EXPECT_EQ( bitlen, var_table2.num() );
+  EXPECT_EQ( body, var_table2.body(0) );
+
+  VarTable var_table3;
+  var_table3 = std::move(var_table2);
+  EXPECT_EQ( bitlen, var_table3.num() );
+  EXPECT_EQ( body, var_table3.body(0) );
+  EXPECT_EQ( 5, var_table3.find(Variable(bitlen, 5)) );
+}
+
+TEST(VarTableTest, var_pool)
+{
+  ymuint n = 20;
+  VarPool var_pool(5);
+  for (ymuint i = 0; i < 3; ++ i) {
+    var_pool.put(Variable(n, i), i);
+    var_pool.put(Variable(n, i), i);
+  }
+  EXPECT_EQ( 3, var_pool.size() );
+  for (ymuint i = 0; i < var_pool.size(); ++ i) {
+    EXPECT_TRUE( var_pool.var(i) == var_pool.var_table().var(var_pool.id(i)) );
+  }
+  for (ymuint i = 3; i < 10; ++ i) {
+    var_pool.put(Variable(n, i), i);
+  }
+  EXPECT_EQ( 5, var_pool.size() );
+}
+
+// VarPool は価値の高いものから k 個を保持する．
+TEST(VarTableTest, var_pool_top)
+{
+  ymuint n = 20;
+  VarPool p(2);
+  double val_list[] = { 0.9, 0.8, 0.1, 0.2 };
+  for (ymuint i = 0; i < 4; ++ i) {
+    p.put(Variable(n, i), val_list[i]);
+  }
+  ASSERT_EQ( 2, p.size() );
+  vector<double> v;
+  for (ymuint i = 0; i < p.size(); ++ i) {
+    v.push_back(p.value(i));
+  }
+  std::sort(v.begin(), v.end());
+  EXPECT_EQ( 0.8, v[0] );
+  EXPECT_EQ( 0.9, v[1] );
+}
+
+// 複数の VarPool をまとめても価値の高いものから k 個が残る．
+TEST(VarTableTest, var_pool_merge)
+{
+  ymuint n = 64;
+  ymuint k = 5;
+  ymuint np = 4;
+  vector<VarPool*> pool_list(np);
+  for (ymuint c = 0; c < np; ++ c) {
+    pool_list[c] = new VarPool(k);
+  }
+  // 変数 i の価値は (i * 37) % 64 とし，プールに巡回的に入れる．
+  // 重複した変数も入れる．
+  for (ymuint i = 0; i < n; ++ i) {
+    double val = static_cast<double>((i * 37) % n);
+    pool_list[i % np]->put(Variable(n, i), val);
+    pool_list[(i + 1) % np]->put(Variable(n, i), val);
+  }
+  VarPool pool(k);
+  for (ymuint c = np; c > 0; -- c) {
+    VarPool& pool1 = *pool_list[c - 1];
+    for (ymuint i = 0; i < pool1.size(); ++ i) {
+      pool.put(pool1.var(i), pool1.value(i));
+    }
+    delete pool_list[c - 1];
+  }
+  ASSERT_EQ( k, pool.size() );
+  vector<double> v;
+  for (ymuint i = 0; i < pool.size(); ++ i) {
+    v.push_back(pool.value(i));
+  }
+  std::sort(v.begin(), v.end());
+  for (ymuint i = 0; i < k; ++ i) {
+    EXPECT_EQ( static_cast<double>(n - k + i), v[i] );
+  }
+}
+
+// 捨てた変数が表に溜まらないことのテスト
+TEST(VarTableTest, var_pool_compact)
+{
+  ymuint n = 64;
+  ymuint k = 5;
+  VarPool pool(k);
+  // 価値が単調に増える変数と価値の低い変数を交互に入れる．
+  vector<double> all_v;
+  for (ymuint i = 0; i < n; ++ i) {
+    for (ymuint j = i + 1; j < n; ++ j) {
+      Variable var(n, i);
+      var *= Variable(n, j);
+      double val = static_cast<double>(i * n + j);
+      pool.put(var, val);
+      pool.put(Variable(n, j), -1.0);
+      all_v.push_back(val);
+    }
+  }
+  ASSERT_EQ( k, pool.size() );
+  EXPECT_GE( k * 4, pool.var_table().num() );
+  vector<double> v;
+  for (ymuint i = 0; i < pool.size(); ++ i) {
+    EXPECT_TRUE( pool.var(i) == pool.var_table().var(pool.id(i)) );
+    v.push_back(pool.value(i));
+  }
+  std::sort(v.begin(), v.end());
+  std::sort(all_v.begin(), all_v.end());
+  ymuint m = all_v.size();
+  for (ymuint i = 0; i < k; ++ i) {
+    EXPECT_EQ( all_v[m - k + i], v[i] );
+  }
+}
+
+// 表を共有する SigFunc のテスト
+TEST(VarTableTest, sig_func)
+{
+  ymuint bitlen = 30;
+  ymuint nv = 100;
+  ostringstream os;
+  os << bitlen << " " << nv << endl;
+  for (ymuint i = 0; i < nv; ++ i) {
+    ymuint64 x = (i + 1) * 0x9E3779B97F4A7C15ULL;
+    for (ymuint j = 0; j < bitlen; ++ j) {
+      x ^= (x << 13);
+      x ^= (x >> 7);
+      x ^= (x << 17);
+      os << ((x & 1ULL) ? '1' : '0');
+    }
+    os << endl;
+  }
+  RvMgr rv_mgr;
+  istringstream is(os.str());
+  ASSERT_TRUE( rv_mgr.read_data(is) );
+  const vector<const RegVect*>& rv_list = rv_mgr.vect_list();
+
+  VarTable var_table;
+  vector<Variable> var_list;
+  vector<ymuint> id_list;
+  for (ymuint i = 0; i < 5; ++ i) {
+    Variable var(bitlen, i);
+    var *= Variable(bitlen, i * 5 + 3);
+    var_list.push_back(var);
+    id_list.push_back(var_table.intern(var));
+  }
+  // 次数の高い変数は密な表現で分類される．
+  {
+    Variable var(bitlen, 0);
+    for (ymuint j = 2; j < bitlen; j += 2) {
+      var *= Variable(bitlen, j);
+    }
+    var_list.push_back(var);
+    id_list.push_back(var_table.intern(var));
+  }
+  SigFunc sf1(var_list);
+  SigFunc sf2(var_table, id_list);
+  EXPECT_EQ( 6, sf2.output_width() );
+  vector<ymuint> val_list;
+  sf2.eval_all(rv_mgr.matrix(), val_list);
+  for (ymuint i = 0; i < rv_list.size(); ++ i) {
+    EXPECT_EQ( sf1.eval(rv_list[i]), sf2.eval(rv_list[i]) );
+    EXPECT_EQ( sf1.eval(rv_list[i]), val_list[i] );
+    EXPECT_EQ( val_list[i], sf2.eval(rv_mgr.matrix(), i) );
+  }
+}
+
+END_NAMESPACE_YM_IGF
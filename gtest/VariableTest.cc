@@ -9,6 +9,7 @@
 
 #include "gtest/gtest.h"
 #include "Variable.h"
+#include "SparseVariable.h"
 
 
 BEGIN_NAMESPACE_YM_IGF
@@ -115,4 +116,117 @@ TEST(VariableTest, large_compose)
   }
 }
 
+// ムーブコンストラクタのテスト
+TEST(VariableTest, move_constructor)
+{
+  // 内部の領域に収まる場合とヒープを用いる場合
+  ymuint n_list[] = { 100, Variable::kInlineSize + 100 };
+  for (ymuint k = 0; k < 2; ++ k) {
+    ymuint n = n_list[k];
+    for (ymuint i = 0; i < n; i += 7) {
+      Variable a(n, i);
+      a *= Variable(n, n - 1 - i);
+      Variable b(a);
+
+      Variable c(std::move(a));
+
+      EXPECT_TRUE( b == c );
+      EXPECT_EQ( n, c.var_size() );
+      EXPECT_EQ( 0, a.var_size() );
+    }
+  }
+}
+
+// 代入演算のテスト
+TEST(VariableTest, assign)
+{
+  // サイズの異なる変数の間で代入を行う．
+  ymuint n1 = 50;
+  ymuint n2 = Variable::kInlineSize * 2 + 3;
+  Variable a(n1, 3);
+  Variable b(n2, n2 - 1);
+  Variable a0(a);
+  Variable b0(b);
+
+  Variable c;
+  c = b;
+  EXPECT_TRUE( c == b0 );
+  c = a;
+  EXPECT_TRUE( c == a0 );
+  c = b;
+  c *= Variable(n2, 0);
+  EXPECT_TRUE( b == b0 );
+  vector<ymuint> vlist = c.vid_list();
+  ASSERT_EQ( 2, vlist.size() );
+  EXPECT_EQ( 0, vlist[0] );
+  EXPECT_EQ( n2 - 1, vlist[1] );
+
+  // ムーブ代入
+  c = std::move(a);
+  EXPECT_TRUE( c == a0 );
+  EXPECT_EQ( 0, a.var_size() );
+  c = std::move(b);
+  EXPECT_TRUE( c == b0 );
+  EXPECT_EQ( 0, b.var_size() );
+  a = std::move(c);
+  EXPECT_TRUE( a == b0 );
+
+  // vector の再配置でも内容は保たれる．
+  vector<Variable> var_list;
+  for (ymuint i = 0; i < 100; ++ i) {
+    ymuint n = (i % 2) ? n1 : n2;
+    var_list.push_back(Variable(n, i % n1));
+  }
+  for (ymuint i = 0; i < 100; ++ i) {
+    ymuint n = (i % 2) ? n1 : n2;
+    EXPECT_TRUE( var_list[i] == Variable(n, i % n1) );
+  }
+}
+
+// 疎な表現との変換のテスト
+TEST(VariableTest, sparse)
+{
+  ymuint n = 300;
+  Variable var(n, 5);
+  var *= Variable(n, 64);
+  var *= Variable(n, 299);
+  EXPECT_EQ( 3, var.degree() );
+  EXPECT_TRUE( SparseVariable::is_preferred_row(var) );
+  EXPECT_TRUE( SparseVariable::is_preferred_column(var) );
+
+  SparseVariable svar = var;
+  EXPECT_EQ( n, svar.var_size() );
+  ASSERT_EQ( 3, svar.degree() );
+  EXPECT_EQ( 5, svar.vid(0) );
+  EXPECT_EQ( 64, svar.vid(1) );
+  EXPECT_EQ( 299, svar.vid(2) );
+  EXPECT_TRUE( svar.dense() == var );
+
+  // ブロック数より次数が大きければ1行ずつの分類では密な表現を用いる．
+  // 列の XOR ではまだ疎な表現のほうが速い．
+  Variable var2(n, 0);
+  for (ymuint i = 1; i < 6; ++ i) {
+    var2 *= Variable(n, i * 50);
+  }
+  EXPECT_EQ( 6, var2.degree() );
+  EXPECT_FALSE( SparseVariable::is_preferred_row(var2) );
+  EXPECT_TRUE( SparseVariable::is_preferred_column(var2) );
+
+  // 次数が 32 × (ブロック数 + 1) を超えると列の XOR でも密な表現を用いる．
+  Variable var3(n, 0);
+  for (ymuint i = 1; i < 200; ++ i) {
+    var3 *= Variable(n, i);
+  }
+  EXPECT_EQ( 200, var3.degree() );
+  EXPECT_FALSE( SparseVariable::is_preferred_column(var3) );
+
+  // 次数 0 の変数も扱える．
+  Variable var0(n, 7);
+  var0 *= Variable(n, 7);
+  EXPECT_EQ( 0, var0.degree() );
+  SparseVariable svar0 = var0;
+  EXPECT_EQ( 0, svar0.degree() );
+  EXPECT_TRUE( svar0.dense() == var0 );
+}
+
 END_NAMESPACE_YM_IGF
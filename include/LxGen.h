@@ -11,13 +11,59 @@
 
 #include "igf.h"
 #include "Variable.h"
+#include "RandStream.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
 
 
 BEGIN_NAMESPACE_IGF
 
+//////////////////////////////////////////////////////////////////////
+/// @class LxGenStats LxGen.h "LxGen.h"
+/// @brief LxGen の途中経過を表す構造体
+//////////////////////////////////////////////////////////////////////
+struct LxGenStats
+{
+  /// @brief 開始からの経過時間(秒)
+  double mTime;
+
+  /// @brief 評価した候補の数
+  ymuint64 mStepNum;
+
+  /// @brief 1秒あたりに評価した候補の数
+  double mStepRate;
+
+  /// @brief これまでに得られた最良の価値
+  ///
+  /// 価値の定義はアルゴリズムによる．
+  double mBestValue;
+
+  /// @brief それまでに得られた変数の階数
+  ///
+  /// 階数を求めないアルゴリズムでは 0 となる．
+  ymuint mRank;
+
+  /// @brief プライマリ変数の階数(mRank の上限)
+  ///
+  /// 階数を求めないアルゴリズムでは 0 となる．
+  ymuint mFullRank;
+
+  /// @brief 打ち切られた時 true となる．
+  bool mInterrupted;
+};
+
+
 //////////////////////////////////////////////////////////////////////
 /// @class LxGen LxGen.h "LxGen.h"
 /// @brief 線形変換用の合成変数を生成する純粋仮想基底クラス
+///
+/// 時間と評価する候補の数の上限を設定できる．
+/// 上限に達するか cancel() が呼ばれると generate() はそれまでに
+/// 得られた変数を var_list に入れて速やかに終了する．
+/// 打ち切りはスレッド間の進み具合に依存するので，
+/// 打ち切られた時の結果は再現性を持たない．
 //////////////////////////////////////////////////////////////////////
 class LxGen
 {
@@ -29,7 +75,11 @@ public:
   LxGen*
   new_obj(string method);
 
+  /// @brief コンストラクタ
+  LxGen();
+
   /// @brief デストラクタ
+  virtual
   ~LxGen() { }
 
 
@@ -48,8 +98,283 @@ public:
 	   ymuint req_num,
 	   vector<Variable>& var_list) = 0;
 
+  /// @brief 用いるスレッド数を設定する．
+  /// @param[in] thread_num スレッド数
+  ///
+  /// 0 の時はハードウェアのスレッド数を用いる．
+  /// 並列化に対応していないアルゴリズムでは無視される．
+  void
+  set_thread_num(ymuint thread_num);
+
+  /// @brief 用いるスレッド数を返す．
+  ymuint
+  thread_num() const;
+
+  /// @brief 独立に動かす探索の数(連鎖数)を設定する．
+  /// @param[in] chain_num 連鎖数 ( > 0 )
+  ///
+  /// マルコフ連鎖を用いるアルゴリズム(MCMC, Anneal など)は
+  /// chain_num 個の連鎖を thread_num() 個のスレッドで分担して動かす．
+  /// 結果は連鎖数と乱数の系列で決まり，スレッド数にはよらない．
+  /// 複数のスレッドを活かすには thread_num() 以上にしておくこと．
+  /// デフォルトは 1 で，1 連鎖分の遷移しか行わない．
+  /// 連鎖を用いないアルゴリズムでは無視される．
+  void
+  set_chain_num(ymuint chain_num);
+
+  /// @brief 連鎖数を返す．
+  ymuint
+  chain_num() const;
+
+  /// @brief 乱数のシードを設定する．
+  /// @param[in] seed シード
+  ///
+  /// set_rand_stream(RandStream(seed)) と同じ
+  void
+  set_seed(ymuint64 seed);
+
+  /// @brief 乱数の系列を設定する．
+  /// @param[in] rs 乱数の系列
+  ///
+  /// 乱数を用いるアルゴリズムはこの系列から派生した系列のみを用いるので，
+  /// 同じ系列を与えればスレッド数によらず同じ結果となる．
+  void
+  set_rand_stream(const RandStream& rs);
+
+  /// @brief 乱数の系列を返す．
+  const RandStream&
+  rand_stream() const;
+
+  /// @brief 時間の上限を設定する．
+  /// @param[in] sec 秒数
+  ///
+  /// 0.0 の時は制限しない．
+  void
+  set_time_limit(double sec);
+
+  /// @brief 評価する候補の数の上限を設定する．
+  /// @param[in] step_num 候補の数
+  ///
+  /// 0 の時は制限しない．
+  /// 上限のチェックはある程度まとめて行うので多少超えることがある．
+  void
+  set_step_limit(ymuint64 step_num);
+
+  /// @brief 途中経過を受け取る関数を設定する．
+  /// @param[in] observer 途中経過を受け取る関数
+  /// @param[in] interval 呼び出しの間隔(秒)
+  ///
+  /// observer は generate() 中に interval 秒程度の間隔で呼ばれ，
+  /// 終了時にも一度呼ばれる．
+  /// 複数のスレッドから呼ばれることがあるが同時に呼ばれることはない．
+  void
+  set_observer(const std::function<void (const LxGenStats&)>& observer,
+	       double interval = 1.0);
+
+  /// @brief 実行中の generate() を打ち切る．
+  ///
+  /// 別のスレッドや observer の中から呼ぶことができる．
+  /// generate() が始まる前に呼んだ場合は次の generate() を打ち切る．
+  void
+  cancel();
+
+  /// @brief 直前の generate() が打ち切られた時 true を返す．
+  bool
+  interrupted() const;
+
+  /// @brief 直前の generate() の結果の階数を返す．
+  ///
+  /// 階数を求めないアルゴリズムでは 0 を返す．
+  ymuint
+  rank() const;
+
+  /// @brief 直前の generate() でのプライマリ変数の階数を返す．
+  ///
+  /// rank() の上限となる．
+  /// 階数を求めないアルゴリズムでは 0 を返す．
+  ymuint
+  full_rank() const;
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスから用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 上限の管理を開始する．
+  ///
+  /// generate() の最初に呼ぶ．
+  void
+  start_budget();
+
+  /// @brief 評価した候補の数を加えて上限をチェックする．
+  /// @param[in] step_num 前回の呼び出しから評価した候補の数
+  /// @param[in] best_value 呼び出し側で得られた最良の価値
+  /// @return 処理を続けてよい時 true を返す．
+  ///
+  /// 複数のスレッドから呼んでもよい．
+  /// 時計を読むので候補ごとではなくある程度まとめて呼ぶこと．
+  bool
+  consume(ymuint64 step_num,
+	  double best_value);
+
+  /// @brief 処理を続けてよい時 true を返す．
+  ///
+  /// 上限に達したか cancel() が呼ばれた後は false を返す．
+  bool
+  running() const;
+
+  /// @brief 上限の管理を終了する．
+  ///
+  /// generate() の最後に呼ぶ．observer に最終結果を通知する．
+  void
+  finish_budget();
+
+  /// @brief 結果の階数を設定する．
+  /// @param[in] rank それまでに得られた変数の階数
+  /// @param[in] full_rank プライマリ変数の階数
+  ///
+  /// 階数を求めるアルゴリズムが start_budget() の後で呼ぶ．
+  void
+  set_rank(ymuint rank,
+	   ymuint full_rank);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // スレッド数
+  ymuint mThreadNum;
+
+  // 連鎖数
+  ymuint mChainNum;
+
+  // 乱数の系列
+  RandStream mRandStream;
+
+  // 時間の上限(秒)
+  double mTimeLimit;
+
+  // 候補の数の上限
+  ymuint64 mStepLimit;
+
+  // 途中経過を受け取る関数
+  std::function<void (const LxGenStats&)> mObserver;
+
+  // observer を呼ぶ間隔(秒)
+  double mInterval;
+
+  // 開始時刻
+  std::chrono::steady_clock::time_point mStartTime;
+
+  // 評価した候補の数
+  std::atomic<ymuint64> mStepCount;
+
+  // 打ち切りフラグ
+  std::atomic<bool> mStop;
+
+  // 結果の階数
+  ymuint mRank;
+
+  // プライマリ変数の階数
+  ymuint mFullRank;
+
+  // cancel() による打ち切り要求
+  // start_budget() では消さず，finish_budget() で消す．
+  std::atomic<bool> mCancel;
+
+  // 以下は mMutex で保護する．
+  std::mutex mMutex;
+
+  // 最良の価値
+  double mBestValue;
+
+  // 前回 observer を呼んだ時刻(秒)
+  double mLastReport;
+
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 用いるスレッド数を返す．
+inline
+ymuint
+LxGen::thread_num() const
+{
+  return mThreadNum;
+}
+
+// @brief 連鎖数を返す．
+inline
+ymuint
+LxGen::chain_num() const
+{
+  return mChainNum;
+}
+
+// @brief 乱数のシードを設定する．
+// @param[in] seed シード
+inline
+void
+LxGen::set_seed(ymuint64 seed)
+{
+  mRandStream = RandStream(seed);
+}
+
+// @brief 乱数の系列を設定する．
+// @param[in] rs 乱数の系列
+inline
+void
+LxGen::set_rand_stream(const RandStream& rs)
+{
+  mRandStream = rs;
+}
+
+// @brief 乱数の系列を返す．
+inline
+const RandStream&
+LxGen::rand_stream() const
+{
+  return mRandStream;
+}
+
+// @brief 直前の generate() が打ち切られた時 true を返す．
+inline
+bool
+LxGen::interrupted() const
+{
+  return mStop || mCancel;
+}
+
+// @brief 直前の generate() の結果の階数を返す．
+inline
+ymuint
+LxGen::rank() const
+{
+  return mRank;
+}
+
+// @brief 直前の generate() でのプライマリ変数の階数を返す．
+inline
+ymuint
+LxGen::full_rank() const
+{
+  return mFullRank;
+}
+
+// @brief 処理を続けてよい時 true を返す．
+inline
+bool
+LxGen::running() const
+{
+  return !mStop && !mCancel;
+}
+
 END_NAMESPACE_IGF
 
 
@@ -41,11 +41,29 @@ public:
   /// @return 分割が成功したら true を返し，割当結果を mapping に入れる．
   ///
   /// mapping[i] には i 番目のベクタの割当先の番号が入る．
+  /// 呼び出しごとに vect_list から RvMatrix を作るので，
+  /// 同じベクタに対して何度も呼ぶ時は RvMatrix を渡す方を用いる．
   bool
   cf_partition(const vector<const RegVect*>& vect_list,
 	       const vector<const SigFunc*>& sigfunc_list,
 	       vector<ymuint>& mapping);
 
+  /// @brief ベクタを分割する．
+  /// @param[in] vect_list ベクタのリスト
+  /// @param[in] rv_mat vect_list から作ったベクタの行列
+  /// @param[in] sigfunc_list シグネチャ関数のリスト
+  /// @param[out] mapping 個々のベクタの割当結果を入れる配列
+  /// @return 分割が成功したら true を返し，割当結果を mapping に入れる．
+  ///
+  /// rv_mat の行は vect_list と同じ順でなければならない．
+  /// RvMgr のベクタに対しては RvMgr::vect_list() と
+  /// RvMgr::matrix() を渡せばよい．
+  bool
+  cf_partition(const vector<const RegVect*>& vect_list,
+	       const RvMatrix& rv_mat,
+	       const vector<const SigFunc*>& sigfunc_list,
+	       vector<ymuint>& mapping);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -59,6 +77,9 @@ private:
     // 元のベクタ
     const RegVect* mVect;
 
+    // ベクタ番号
+    ymuint mPos;
+
     // 現在の割当先のスロット
     Slot* mCurSlot;
 
@@ -101,6 +122,11 @@ private:
   // シグネチャ関数ごとのスロットの配列
   vector<vector<Slot> > mSlotArray;
 
+  // ベクタごとのシグネチャの配列
+  // i 番目のベクタの j 番目のシグネチャ関数の値は
+  // mSigArray[i * nb + j] に入る(nb はシグネチャ関数の数)．
+  vector<ymuint> mSigArray;
+
 };
 
 END_NAMESPACE_IGF
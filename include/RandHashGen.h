@@ -10,7 +10,7 @@
 
 
 #include "igf.h"
-#include "ym/RandGen.h"
+#include "RandStream.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -35,6 +35,11 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の系列を設定する．
+  /// @param[in] rs 乱数の系列
+  void
+  set_rand_stream(const RandStream& rs);
+
   /// @brief ランダムにハッシュ関数を作る．
   /// @param[in] input_num 入力数
   /// @param[in] output_num 出力数
@@ -50,8 +55,8 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 乱数生成機
-  RandGen mRandGen;
+  // 乱数の系列
+  RandStream mRandStream;
 
 };
 
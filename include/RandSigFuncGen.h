@@ -10,8 +10,8 @@
 
 
 #include "igf.h"
-#include "ym/RandCombiGen.h"
-#include "ym/RandGen.h"
+#include "VarTable.h"
+#include "RandStream.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -38,6 +38,11 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の系列を設定する．
+  /// @param[in] rs 乱数の系列
+  void
+  set_rand_stream(const RandStream& rs);
+
   /// @brief 初期化を行う．
   /// @param[in] rv_list 登録ベクタのリスト
   /// @param[in] var_list 変数のリスト
@@ -52,6 +57,12 @@ public:
        ymuint m);
 
   /// @brief signature function を m 個生成する．
+  ///
+  /// 生成のたびに乱数の系列から派生した系列を用いるので，
+  /// 同じ系列を設定すれば同じ順で同じ関数が得られる．
+  ///
+  /// 生成された SigFunc はこのオブジェクトの変数の表を共有するので，
+  /// このオブジェクトが存在して init() が再び呼ばれるまでの間のみ有効
   vector<const SigFunc*>
   generate();
 
@@ -61,14 +72,18 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 変数選択用の乱数発生器
-  RandGen mRgChoose;
+  // 変数選択用の乱数の系列
+  RandStream mRandStream;
+
+  // generate() を呼んだ回数
+  ymuint64 mGenCount;
 
-  // 組み合わせ選択器
-  RandCombiGen* mRcg;
+  // 変数の表
+  // generate() で作った SigFunc はこの表を共有する．
+  VarTable mVarTable;
 
-  // 変数のリスト
-  vector<Variable> mVarList;
+  // 変数の番号のリスト
+  vector<ymuint> mIdList;
 
   // 出力のビット幅
   ymuint mWidth;
@@ -0,0 +1,199 @@
+#ifndef RANDSTREAM_H
+#define RANDSTREAM_H
+
+/// @file RandStream.h
+/// @brief RandStream のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class RandStream RandStream.h "RandStream.h"
+/// @brief 分割可能な乱数の系列
+///
+/// 鍵とカウンタから mix(鍵 + カウンタ * γ) で乱数を作る
+/// カウンタ方式の乱数発生器(splitmix64 と同じ出力関数を用いる)．
+/// split(index) で鍵から派生した別の系列を作ることができる．
+/// 派生した系列の内容は元の系列の鍵と index のみで決まり，
+/// 元の系列からそれまでに取り出した数には依存しないので，
+/// 並列に処理する各タスクに split(タスク番号) を割り当てれば
+/// スレッド数や実行順によらず同じ結果が得られる．
+///
+/// 関数名は ym の RandGen に合わせてある．
+//////////////////////////////////////////////////////////////////////
+class RandStream
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] seed シード
+  explicit
+  RandStream(ymuint64 seed = 0);
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 派生した系列を返す．
+  /// @param[in] index 番号
+  ///
+  /// 同じ系列から同じ番号で派生した系列は同じ内容となる．
+  RandStream
+  split(ymuint64 index) const;
+
+  /// @brief 64ビットの乱数を返す．
+  ymuint64
+  int64();
+
+  /// @brief 32ビットの乱数を返す．
+  ymuint32
+  int32();
+
+  /// @brief [0, 1] の実数の乱数を返す．
+  double
+  real1();
+
+  /// @brief [0, 1) の実数の乱数を返す．
+  double
+  real2();
+
+  /// @brief n 個の中から k 個をランダムに選ぶ．
+  /// @param[in] n 要素数
+  /// @param[in] k 選ぶ数 ( k <= n )
+  /// @param[out] elem_list 選ばれた要素番号のリスト
+  void
+  combination(ymuint n,
+	      ymuint k,
+	      vector<ymuint>& elem_list);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 64ビットの値をかき混ぜる．
+  static
+  ymuint64
+  mix(ymuint64 z);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 鍵
+  ymuint64 mKey;
+
+  // カウンタ
+  ymuint64 mCounter;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] seed シード
+inline
+RandStream::RandStream(ymuint64 seed) :
+  mKey(mix(seed ^ 0x6A09E667F3BCC909ULL)),
+  mCounter(0)
+{
+}
+
+// @brief 派生した系列を返す．
+// @param[in] index 番号
+inline
+RandStream
+RandStream::split(ymuint64 index) const
+{
+  RandStream rs;
+  rs.mKey = mix(mKey ^ mix(index + 0xBB67AE8584CAA73BULL));
+  rs.mCounter = 0;
+  return rs;
+}
+
+// @brief 64ビットの乱数を返す．
+inline
+ymuint64
+RandStream::int64()
+{
+  ++ mCounter;
+  return mix(mKey + mCounter * 0x9E3779B97F4A7C15ULL);
+}
+
+// @brief 32ビットの乱数を返す．
+inline
+ymuint32
+RandStream::int32()
+{
+  return static_cast<ymuint32>(int64() >> 32);
+}
+
+// @brief [0, 1] の実数の乱数を返す．
+inline
+double
+RandStream::real1()
+{
+  return static_cast<double>(int64() >> 11) * (1.0 / 9007199254740991.0);
+}
+
+// @brief [0, 1) の実数の乱数を返す．
+inline
+double
+RandStream::real2()
+{
+  return static_cast<double>(int64() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// @brief n 個の中から k 個をランダムに選ぶ．
+// @param[in] n 要素数
+// @param[in] k 選ぶ数 ( k <= n )
+// @param[out] elem_list 選ばれた要素番号のリスト
+//
+// Fisher-Yates のシャッフルを k 回で打ち切ったもの
+inline
+void
+RandStream::combination(ymuint n,
+			ymuint k,
+			vector<ymuint>& elem_list)
+{
+  ASSERT_COND( k <= n );
+  vector<ymuint> tmp_list(n);
+  for (ymuint i = 0; i < n; ++ i) {
+    tmp_list[i] = i;
+  }
+  elem_list.resize(k);
+  for (ymuint i = 0; i < k; ++ i) {
+    ymuint j = i + int32() % (n - i);
+    std::swap(tmp_list[i], tmp_list[j]);
+    elem_list[i] = tmp_list[i];
+  }
+}
+
+// @brief 64ビットの値をかき混ぜる．
+inline
+ymuint64
+RandStream::mix(ymuint64 z)
+{
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+END_NAMESPACE_IGF
+
+#endif // RANDSTREAM_H
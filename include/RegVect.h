@@ -18,12 +18,15 @@ BEGIN_NAMESPACE_IGF
 /// @class RegVect RegVect.h "RegVect.h"
 /// @brief 登録ベクタを表すクラス
 ///
-/// 実際に確保されるサイズは sizeof(RegVect) と異なるので RvMgr 以外が
-/// このクラスのインスタンスを生成することを禁止している．
+/// 実際に確保されるサイズは sizeof(RegVect) と異なるので RvMgr(RvStream)
+/// 以外がこのクラスのインスタンスを生成することを禁止している．
+/// RvMatrix は内容をコピーするために mBody を直接参照する．
 //////////////////////////////////////////////////////////////////////
 class RegVect
 {
   friend class RvMgr;
+  friend class RvStream;
+  friend class RvMatrix;
 private:
 
   /// @brief コンストラクタ
@@ -62,8 +65,26 @@ public:
   ymuint
   classify(const Variable& var) const;
 
-  /// @brief ハッシュ値を返す．
+  /// @brief ブロック列で分類する．
+  /// @param[in] mask 分類用の変数のブロック列
+  ///
+  /// mask は Variable::raw_data() と同じ形式で
+  /// (size() + 63) / 64 個のブロックを持たなければならない．
+  /// VarTable::body() をそのまま渡すために用いる．
+  /// 0 か 1 を返す．
+  ymuint
+  classify(const ymuint64* mask) const;
+
+  /// @brief 疎な表現の変数で分類する．
+  /// @param[in] var 分類用の変数
+  ///
+  /// 計算量は var の次数に比例する．
+  /// 0 か 1 を返す．
   ymuint
+  classify(const SparseVariable& var) const;
+
+  /// @brief ハッシュ値を返す．
+  ymuint64
   hash() const;
 
   /// @brief 内容を出力する．
@@ -0,0 +1,461 @@
+#ifndef RVMATRIX_H
+#define RVMATRIX_H
+
+/// @file RvMatrix.h
+/// @brief RvMatrix のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class RvMatrix RvMatrix.h "RvMatrix.h"
+/// @brief 登録ベクタの集合を連続した領域に格納したもの
+///
+/// 各ベクタのブロック(RegVect::mBody と同じ形式)を行として
+/// 1つの整列された領域に並べる．
+/// pos 番目の行は row(pos) から block_size() 個のブロックとなる．
+/// 元のベクタのインデックスは別の配列に保持する．
+///
+/// ベクタの集合全体を何度も走査する処理はポインタをたどる
+/// vector<const RegVect*> よりもこちらを用いたほうが効率がよい．
+///
+/// 同時に転置したもの(列)も保持する．
+/// column(j) は全ベクタの j ビット目を並べた vect_num() ビットの
+/// ビットベクタ(column_size() ブロック)で，pos 番目のビットが
+/// pos 番目の行に対応する．
+/// 変数による全ベクタの分類結果は変数に含まれる列の XOR となる．
+///
+/// 行ごとの分類は実行環境の CPU に応じて AVX-512/AVX2/POPCNT
+/// 命令を用いたカーネルで複数行をまとめて行う．
+//////////////////////////////////////////////////////////////////////
+class RvMatrix
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  RvMatrix();
+
+  /// @brief ベクタのリストを指定したコンストラクタ
+  /// @param[in] rv_list ベクタのリスト
+  explicit
+  RvMatrix(const vector<const RegVect*>& rv_list);
+
+  /// @brief デストラクタ
+  ~RvMatrix();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を設定する．
+  /// @param[in] rv_list ベクタのリスト
+  ///
+  /// 以前の内容は破棄される．
+  void
+  set(const vector<const RegVect*>& rv_list);
+
+  /// @brief 内容を空にする．
+  void
+  clear();
+
+  /// @brief ベクタのサイズ(ビット長)を得る．
+  ymuint
+  vect_size() const;
+
+  /// @brief ベクタ数を得る．
+  ymuint
+  vect_num() const;
+
+  /// @brief 1行あたりのブロック数を得る．
+  ymuint
+  block_size() const;
+
+  /// @brief 行のブロックの先頭を得る．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  const ymuint64*
+  row(ymuint pos) const;
+
+  /// @brief 行に対応するベクタのインデックスを得る．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  ymuint
+  index(ymuint pos) const;
+
+  /// @brief 値を返す．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  /// @param[in] bit ビット位置 ( 0 <= bit < vect_size() )
+  ///
+  /// RegVect::val() と同じ
+  ymuint
+  val(ymuint pos,
+      ymuint bit) const;
+
+  /// @brief 行を分類する．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  /// @param[in] var 分類用の変数
+  ///
+  /// RegVect::classify() と同じく 0 か 1 を返す．
+  ymuint
+  classify(ymuint pos,
+	   const Variable& var) const;
+
+  /// @brief ブロック列で行を分類する．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  /// @param[in] mask 分類用の変数のブロック列(block_size() 個)
+  ///
+  /// VarTable::body() をそのまま渡すために用いる．
+  ymuint
+  classify(ymuint pos,
+	   const ymuint64* mask) const;
+
+  /// @brief 疎な表現の変数で行を分類する．
+  /// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+  /// @param[in] var 分類用の変数
+  ///
+  /// 計算量は var の次数に比例する．
+  ymuint
+  classify(ymuint pos,
+	   const SparseVariable& var) const;
+
+  /// @brief 連続した行をまとめて分類する．
+  /// @param[in] var 分類用の変数
+  /// @param[in] pos 先頭の行番号
+  /// @param[in] num 行数 ( pos + num <= vect_num() )
+  /// @param[out] bits 分類結果を格納する領域
+  ///
+  /// bits の i ビット目が classify(pos + i, var) となる．
+  /// bits は (num + 63) / 64 ブロック以上の大きさを持つ必要がある．
+  void
+  classify_rows(const Variable& var,
+		ymuint pos,
+		ymuint num,
+		ymuint64* bits) const;
+
+  /// @brief 連続した行をブロック列でまとめて分類する．
+  /// @param[in] mask 分類用の変数のブロック列(block_size() 個)
+  /// @param[in] pos 先頭の行番号
+  /// @param[in] num 行数 ( pos + num <= vect_num() )
+  /// @param[out] bits 分類結果を格納する領域
+  ///
+  /// マスクを作らずに済むので VarTable::body() を渡す場合に用いる．
+  void
+  classify_rows(const ymuint64* mask,
+		ymuint pos,
+		ymuint num,
+		ymuint64* bits) const;
+
+  /// @brief 1列あたりのブロック数を得る．
+  ymuint
+  column_size() const;
+
+  /// @brief 列のブロックの先頭を得る．
+  /// @param[in] bit ビット位置 ( 0 <= bit < vect_size() )
+  const ymuint64*
+  column(ymuint bit) const;
+
+  /// @brief すべての行を分類する．
+  /// @param[in] var 分類用の変数
+  /// @return 分類結果を表す vect_num() ビットのビットベクタ
+  ///
+  /// 結果の pos 番目のビットが classify(pos, var) となる．
+  /// 結果のブロック数は column_size() で，余りのビットは 0 となる．
+  vector<ymuint64>
+  classify_all(const Variable& var) const;
+
+  /// @brief すべての行を分類する．
+  /// @param[in] var 分類用の変数
+  /// @param[out] bits 分類結果を格納する領域
+  ///
+  /// bits は column_size() ブロック以上の大きさを持つ必要がある．
+  void
+  classify_all(const Variable& var,
+	       ymuint64* bits) const;
+
+  /// @brief 疎な表現の変数ですべての行を分類する．
+  /// @param[in] var 分類用の変数
+  /// @param[out] bits 分類結果を格納する領域
+  ///
+  /// var に含まれる列の XOR を求める．
+  /// bits は column_size() ブロック以上の大きさを持つ必要がある．
+  void
+  classify_all(const SparseVariable& var,
+	       ymuint64* bits) const;
+
+  /// @brief 変数で 1 に分類される行数を数える．
+  /// @param[in] var 分類用の変数
+  ///
+  /// 0 に分類される行数は vect_num() からこの値を引いたもの
+  /// 次数の低い変数は転置した列の XOR で，
+  /// 高い変数(SparseVariable::is_preferred_column() が false)は
+  /// 行ごとの分類で数える．
+  ymuint64
+  count1(const Variable& var) const;
+
+  /// @brief 分類結果に変数の分類結果を合成して 1 の数を数える．
+  /// @param[in] var 分類用の変数
+  /// @param[in] src 分類結果のビットベクタ(column_size() ブロック)
+  /// @param[out] dst 結果を格納するビットベクタ(column_size() ブロック)
+  /// @return dst 中の 1 の数
+  ///
+  /// src を変数 v の分類結果とすると dst は v * var の分類結果となる．
+  /// dst は src と同じでもよい．
+  /// count1() と同じく変数の次数で列の XOR か行ごとの分類かを選ぶ．
+  ymuint64
+  xor_classify(const Variable& var,
+	       const ymuint64* src,
+	       ymuint64* dst) const;
+
+  /// @brief 複数の変数で 1 に分類される行数をまとめて数える．
+  /// @param[in] var_list 分類用の変数のリスト
+  /// @param[out] n1_list 結果を格納するリスト
+  ///
+  /// n1_list[i] に count1(var_list[i]) の値が入る．
+  /// 転置した列をブロック単位でキャッシュに載せたまま
+  /// すべての変数の分類を行う(GF(2) 上の行列積)ので，
+  /// 変数の数によらず全体の走査は1回で済む．
+  void
+  count1(const vector<Variable>& var_list,
+	 vector<ymuint64>& n1_list) const;
+
+  /// @brief joint_count() で扱える変数の最大数
+  static
+  const ymuint kJointMax = 10;
+
+  /// @brief 複数の変数による分類結果の同時分布を求める．
+  /// @param[in] bits_list 分類結果のビットベクタのリスト
+  /// @param[out] hist 結果を格納するリスト
+  ///
+  /// bits_list の要素は classify_all() の結果と同じ形式
+  /// (column_size() ブロック)のビットベクタとする．
+  /// 要素数を t とすると hist は 2^t 個の要素を持ち，
+  /// hist[p] には i 番目の分類結果が p の i ビット目と等しい
+  /// 行の数が入る．
+  /// 行ごとに分岐せずにビットベクタの AND/ANDN と popcount のみで
+  /// 求める．t は kJointMax 以下でなければならない．
+  void
+  joint_count(const vector<const ymuint64*>& bits_list,
+	      vector<ymuint64>& hist) const;
+
+  /// @brief 複数の変数による分類の同時分布を求める．
+  /// @param[in] var_list 分類用の変数のリスト
+  /// @param[out] hist 結果を格納するリスト
+  ///
+  /// 各変数の分類結果を classify_all() で求めてから上の関数を呼ぶ．
+  /// ただし，すべての変数の次数が高い場合は行ごとに分類して直接数える．
+  void
+  joint_count(const vector<Variable>& var_list,
+	      vector<ymuint64>& hist) const;
+
+  /// @brief ビットベクタ中の 1 の数を数える．
+  /// @param[in] bits ビットベクタ
+  /// @param[in] n ブロック数
+  static
+  ymuint64
+  count_bits(const ymuint64* bits,
+	     ymuint n);
+
+  /// @brief 2つのビットベクタの XOR を求めて 1 の数を数える．
+  /// @param[in] src1, src2 ビットベクタ
+  /// @param[out] dst 結果を格納するビットベクタ
+  /// @param[in] n ブロック数
+  /// @return dst 中の 1 の数
+  ///
+  /// dst は src1 か src2 と同じでもよい．
+  /// 分類結果のビットベクタの合成に用いる．
+  static
+  ymuint64
+  xor_bits(const ymuint64* src1,
+	   const ymuint64* src2,
+	   ymuint64* dst,
+	   ymuint n);
+
+  /// @brief 64ビット中の 1 の数を数える．
+  /// @param[in] data 対象のデータ
+  static
+  ymuint
+  popcount(ymuint64 data);
+
+  /// @brief 64ビットのパリティを求める．
+  /// @param[in] data 対象のデータ
+  static
+  ymuint
+  parity(ymuint64 data);
+
+  /// @brief 行の分類と数え上げに用いるカーネルを選ぶ．
+  /// @param[in] name カーネル名 ("avx512", "avx2", "popcnt", "scalar")
+  /// @retval true 選択した．
+  /// @retval false 名前が不正か実行環境で使用できなかった．
+  ///
+  /// 空文字列の場合には使用可能なもののうち最良のものを選ぶ．
+  /// 通常は自動的に選ばれるので呼ぶ必要はない．
+  static
+  bool
+  select_kernel(const string& name);
+
+  /// @brief 現在のカーネル名を返す．
+  static
+  const char*
+  kernel_name();
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief コピーコンストラクタは禁止
+  RvMatrix(const RvMatrix& src);
+
+  /// @brief 代入演算子は禁止
+  const RvMatrix&
+  operator=(const RvMatrix& src);
+
+  /// @brief 列の範囲 [w0, w1) のブロックについて分類を行う．
+  /// @param[in] var 分類用の変数
+  /// @param[in] w0, w1 ブロックの範囲
+  /// @param[out] acc 結果を格納する領域(w1 - w0 ブロック)
+  void
+  classify_range(const Variable& var,
+		 ymuint w0,
+		 ymuint w1,
+		 ymuint64* acc) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ベクタのサイズ
+  ymuint mVectSize;
+
+  // 1行あたりのブロック数
+  ymuint mBlockSize;
+
+  // ベクタ数
+  ymuint mVectNum;
+
+  // ブロックの本体
+  // 64 バイト境界に整列している．
+  ymuint64* mBody;
+
+  // インデックスの配列
+  vector<ymuint> mIndexArray;
+
+  // 1列あたりのブロック数
+  ymuint mColumnSize;
+
+  // 転置したブロックの本体
+  // 64 バイト境界に整列している．
+  ymuint64* mColBody;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ベクタのサイズ(ビット長)を得る．
+inline
+ymuint
+RvMatrix::vect_size() const
+{
+  return mVectSize;
+}
+
+// @brief ベクタ数を得る．
+inline
+ymuint
+RvMatrix::vect_num() const
+{
+  return mVectNum;
+}
+
+// @brief 1行あたりのブロック数を得る．
+inline
+ymuint
+RvMatrix::block_size() const
+{
+  return mBlockSize;
+}
+
+// @brief 行のブロックの先頭を得る．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+inline
+const ymuint64*
+RvMatrix::row(ymuint pos) const
+{
+  ASSERT_COND( pos < vect_num() );
+  return mBody + static_cast<ymuint64>(pos) * mBlockSize;
+}
+
+// @brief 行に対応するベクタのインデックスを得る．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+inline
+ymuint
+RvMatrix::index(ymuint pos) const
+{
+  ASSERT_COND( pos < vect_num() );
+  return mIndexArray[pos];
+}
+
+// @brief 値を返す．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+// @param[in] bit ビット位置 ( 0 <= bit < vect_size() )
+inline
+ymuint
+RvMatrix::val(ymuint pos,
+	      ymuint bit) const
+{
+  ASSERT_COND( bit < vect_size() );
+  return (row(pos)[bit / 64] >> (bit % 64)) & 1ULL;
+}
+
+// @brief 1列あたりのブロック数を得る．
+inline
+ymuint
+RvMatrix::column_size() const
+{
+  return mColumnSize;
+}
+
+// @brief 列のブロックの先頭を得る．
+// @param[in] bit ビット位置 ( 0 <= bit < vect_size() )
+inline
+const ymuint64*
+RvMatrix::column(ymuint bit) const
+{
+  ASSERT_COND( bit < vect_size() );
+  return mColBody + static_cast<ymuint64>(bit) * mColumnSize;
+}
+
+// @brief 64ビット中の 1 の数を数える．
+// @param[in] data 対象のデータ
+inline
+ymuint
+RvMatrix::popcount(ymuint64 data)
+{
+  return __builtin_popcountll(data);
+}
+
+// @brief 64ビットのパリティを求める．
+// @param[in] data 対象のデータ
+inline
+ymuint
+RvMatrix::parity(ymuint64 data)
+{
+  return __builtin_parityll(data);
+}
+
+END_NAMESPACE_IGF
+
+#endif // RVMATRIX_H
@@ -10,11 +10,14 @@
 
 
 #include "igf.h"
+#include "RvMatrix.h"
 #include "ym/UnitAlloc.h"
 
 
 BEGIN_NAMESPACE_IGF
 
+class RvHash;
+
 //////////////////////////////////////////////////////////////////////
 /// @class RvMgr RvMgr.h "RvMgr.h"
 /// @brief RegVect を管理するクラス
@@ -58,6 +61,55 @@ public:
   bool
   read_data(istream& s);
 
+  /// @brief ファイルからデータを読み込む．
+  /// @param[in] filename ファイル名
+  /// @param[in] thread_num 解析に用いるスレッド数
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// ファイルをメモリにマップして直接解析する．
+  /// データの形式，重複の扱い，エラーメッセージは
+  /// read_data(istream& s) と同じ．
+  ///
+  /// thread_num が 2 以上の時は入力を行の範囲で分割して
+  /// 並列に解析する．0 の時はハードウェアのスレッド数を用いる．
+  /// 重複の除去は決定的に行われるので，インデックスは
+  /// スレッド数によらず出現順に割り当てられる．
+  bool
+  read_data(const string& filename,
+	    ymuint thread_num = 1);
+
+  /// @brief 内容をバイナリ形式(.rvb)で書き出す．
+  /// @param[in] filename ファイル名
+  /// @retval true 書き出しが成功した．
+  /// @retval false 書き出しが失敗した．
+  ///
+  /// 形式は 32 バイトのヘッダ
+  /// - マジックナンバー "RVB1" (4 バイト)
+  /// - ベクタのビット長 (ymuint32)
+  /// - ブロック数 (ymuint32)
+  /// - レコードのバイト数 (ymuint32)
+  /// - ベクタ数 (ymuint64)
+  /// - 予約 (ymuint64)
+  /// の後にベクタ数分のレコードが続く．
+  /// 各レコードは RegVect のメモリイメージそのもので，
+  /// サイズ，インデックスの後に mBody と同一の ymuint64
+  /// のブロックが並ぶ．バイトオーダーは実行環境のものとなる．
+  bool
+  write_binary(const string& filename) const;
+
+  /// @brief バイナリ形式(.rvb)のファイルをマップする．
+  /// @param[in] filename ファイル名
+  /// @retval true マップが成功した．
+  /// @retval false マップが失敗した．
+  ///
+  /// ファイルの内容は解析もコピーもされず，マップされた領域を
+  /// 直接 RegVect として参照する．そのため実際の読み込みは
+  /// アクセスされたページごとに遅延して行われる．
+  /// マップはこのオブジェクトが削除されるまで保持される．
+  bool
+  map_binary(const string& filename);
+
   /// @brief ベクタのサイズを得る．
   ///
   /// ベクタのサイズとはベクタのビット長
@@ -68,6 +120,13 @@ public:
   const vector<const RegVect*>&
   vect_list() const;
 
+  /// @brief ベクタを連続した領域に格納した行列を得る．
+  ///
+  /// 行の順番は vect_list() と同じ．
+  /// 最初に呼ばれた時に作られ，次に読み込みが行われるまで保持される．
+  const RvMatrix&
+  matrix() const;
+
   /// @brief 変数の価値を計算する．
   /// @param[in] var 変数
   ///
@@ -83,6 +142,14 @@ public:
   value(const Variable& var1,
 	const Variable& var2) const;
 
+  /// @brief 複数の変数の組の価値を計算する．
+  /// @param[in] var_list 変数のリスト
+  ///
+  /// 価値とはその変数の組で区別できる要素対の数
+  /// 変数の数は RvMatrix::kJointMax 以下でなければならない．
+  double
+  value(const vector<Variable>& var_list) const;
+
   /// @brief インデックスのサイズを得る．
   ///
   /// インデックスのサイズとはインデックスを2進符号化するのに
@@ -90,6 +157,14 @@ public:
   ymuint
   index_size() const;
 
+  /// @brief 直前の read_data() での重複チェックの統計情報を出力する．
+  /// @param[in] s 出力先のストリーム
+  ///
+  /// 探索回数，平均プローブ長，最大プローブ長を出力する．
+  /// 平均プローブ長が 1 に近いほどハッシュ値の分布が良い．
+  void
+  print_hash_stats(ostream& s) const;
+
 #if 0
   /// @brief ベクタにハッシュ関数を適用した結果を作る．
   /// @param[in] hash_func ハッシュ関数
@@ -115,6 +190,42 @@ private:
   void
   set_size(ymuint size);
 
+  /// @brief 読み込み処理の本体
+  /// @param[in] begin, end データの先頭と末尾
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_body(const char* begin,
+	    const char* end);
+
+  /// @brief 読み込み処理の本体(並列版)
+  /// @param[in] begin, end データの先頭と末尾
+  /// @param[in] thread_num スレッド数
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  bool
+  read_body_mt(const char* begin,
+	       const char* end,
+	       ymuint thread_num);
+
+  /// @brief 1行分のデータをベクタに変換して登録する．
+  /// @param[in] str 行の先頭
+  /// @param[in] len 行の長さ(改行は含まない)
+  /// @param[in] line 行番号(エラーメッセージ用)
+  /// @param[in] vect_hash 重複チェック用のハッシュ表
+  /// @retval true 変換が成功した．
+  /// @retval false 不正なデータだった．
+  bool
+  read_line(const char* str,
+	    ymuint len,
+	    ymuint line,
+	    RvHash& vect_hash);
+
+  /// @brief 重複チェックの統計情報を記録する．
+  /// @param[in] vect_hash 重複チェックに用いたハッシュ表
+  void
+  set_hash_stats(const RvHash& vect_hash);
+
   /// @brief ベクタを作る．
   /// @param[in] index インデックス
   RegVect*
@@ -146,6 +257,27 @@ private:
   // ベクタのリスト
   vector<const RegVect*> mVectList;
 
+  // mVectList の内容を連続領域に格納したもの
+  mutable RvMatrix mMatrix;
+
+  // mMatrix が mVectList と一致している時 true
+  mutable bool mMatrixValid;
+
+  // map_binary() でマップした領域の先頭
+  void* mMapAddr;
+
+  // map_binary() でマップした領域のサイズ
+  ymuint64 mMapSize;
+
+  // 重複チェックでの探索回数
+  ymuint64 mProbeNum;
+
+  // 重複チェックでのプローブ長の総和
+  ymuint64 mProbeTotal;
+
+  // 重複チェックでのプローブ長の最大値
+  ymuint64 mProbeMax;
+
 };
 
 
@@ -0,0 +1,187 @@
+#ifndef RVSTREAM_H
+#define RVSTREAM_H
+
+/// @file RvStream.h
+/// @brief RvStream のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+#include <cstdio>
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class RvStream RvStream.h "RvStream.h"
+/// @brief 登録ベクタをチャンク単位で扱うクラス
+///
+/// RvMgr と異なりすべてのベクタをメモリ上に置かない．
+/// 重複の除去は外部ソートで行い，結果は .rvb 形式
+/// (RvMgr::write_binary() 参照)の一時ファイルに保持する．
+/// メモリ上に置かれるのは高々 chunk_size 個のベクタである．
+///
+/// 使い方は以下の通り．
+/// @code
+/// for (rs.rewind(); rs.next_chunk(); ) {
+///   const vector<const RegVect*>& rv_list = rs.chunk();
+///   ...
+/// }
+/// @endcode
+//////////////////////////////////////////////////////////////////////
+class RvStream
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] chunk_size 一度にメモリ上に置くベクタ数
+  RvStream(ymuint chunk_size = 1U << 20);
+
+  /// @brief デストラクタ
+  ~RvStream();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief テキスト形式のデータを読み込む．
+  /// @param[in] s 読み込み元のストリーム
+  /// @retval true 読み込みが成功した．
+  /// @retval false 読み込みが失敗した．
+  ///
+  /// データの形式，重複の扱い，エラーメッセージは
+  /// RvMgr::read_data() と同じ．
+  bool
+  read_data(istream& s);
+
+  /// @brief バイナリ形式(.rvb)のファイルを開く．
+  /// @param[in] filename ファイル名
+  /// @retval true 成功した．
+  /// @retval false 失敗した．
+  bool
+  open_binary(const string& filename);
+
+  /// @brief ベクタのサイズを得る．
+  ymuint
+  vect_size() const;
+
+  /// @brief ベクタ数を得る．
+  ymuint64
+  vect_num() const;
+
+  /// @brief インデックスのサイズを得る．
+  ///
+  /// RvMgr::index_size() と同じ
+  ymuint
+  index_size() const;
+
+  /// @brief 先頭のチャンクに戻る．
+  void
+  rewind();
+
+  /// @brief 次のチャンクを読み込む．
+  /// @retval true 読み込んだ．
+  /// @retval false もうベクタが残っていなかった．
+  ///
+  /// 以前のチャンクのベクタは無効になる．
+  bool
+  next_chunk();
+
+  /// @brief 現在のチャンクのベクタのリストを得る．
+  const vector<const RegVect*>&
+  chunk() const;
+
+  /// @brief 変数の価値を計算する．
+  /// @param[in] var 変数
+  ///
+  /// RvMgr::value() と同じ値をチャンクごとの走査で求める．
+  /// 走査の途中で呼んでもよい．現在のチャンクと次に読むチャンクは変わらない．
+  double
+  value(const Variable& var);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 一時ファイルを閉じて初期状態に戻す．
+  void
+  clear();
+
+  /// @brief ベクタのサイズを設定する．
+  void
+  set_size(ymuint size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // チャンクのサイズ
+  ymuint mChunkSize;
+
+  // ベクタのサイズ
+  ymuint mVectSize;
+
+  // ブロックサイズ
+  ymuint mBlockSize;
+
+  // RegVect のサイズ
+  ymuint mRvSize;
+
+  // ベクタ数
+  ymuint64 mVectNum;
+
+  // ベクタを格納しているファイル
+  FILE* mFile;
+
+  // 読み出したベクタ数
+  ymuint64 mReadNum;
+
+  // チャンクのバッファ
+  vector<ymuint64> mBuff;
+
+  // 現在のチャンクのベクタのリスト
+  vector<const RegVect*> mChunk;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ベクタのサイズを得る．
+inline
+ymuint
+RvStream::vect_size() const
+{
+  return mVectSize;
+}
+
+// @brief ベクタ数を得る．
+inline
+ymuint64
+RvStream::vect_num() const
+{
+  return mVectNum;
+}
+
+// @brief 現在のチャンクのベクタのリストを得る．
+inline
+const vector<const RegVect*>&
+RvStream::chunk() const
+{
+  return mChunk;
+}
+
+END_NAMESPACE_IGF
+
+#endif // RVSTREAM_H
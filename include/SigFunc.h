@@ -10,6 +10,7 @@
 
 
 #include "igf.h"
+#include "SparseVariable.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -19,6 +20,16 @@ BEGIN_NAMESPACE_IGF
 /// @brief シグネチャ関数を表すクラス
 ///
 /// 登録ベクタ(RegVect) を入力としてシグネチャを出力する関数
+///
+/// 各出力ビットの変数は VarTable 中の番号で保持する．
+/// 表を指定したコンストラクタの場合は表を共有するので
+/// 表はこのオブジェクトよりも長く存在しなければならない．
+/// 変数のリストを指定したコンストラクタの場合は自前の表を持つ．
+///
+/// 次数の低い出力は SparseVariable に変換して保持し，
+/// 分類の計算量を次数に比例させる．
+/// 1行ずつの分類(eval())と列の XOR による全行の分類(eval_all())では
+/// 手間の見積もりが異なるので，疎な表現を用いるかどうかは別々に決める．
 //////////////////////////////////////////////////////////////////////
 class SigFunc
 {
@@ -28,6 +39,12 @@ public:
   /// @param[in] var_list 変数のリスト
   SigFunc(const vector<Variable>& var_list);
 
+  /// @brief 変数の表を共有するコンストラクタ
+  /// @param[in] var_table 変数の表
+  /// @param[in] id_list 変数の番号のリスト
+  SigFunc(const VarTable& var_table,
+	  const vector<ymuint>& id_list);
+
   /// @brief デストラクタ
   ~SigFunc();
 
@@ -46,19 +63,77 @@ public:
   ymuint
   eval(const RegVect* rv) const;
 
+  /// @brief 関数値を求める．
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[in] pos 行番号
+  ///
+  /// rv_mat の pos 番目の行に対して eval() と同じ値を返す．
+  ymuint
+  eval(const RvMatrix& rv_mat,
+       ymuint pos) const;
+
+  /// @brief すべての行の関数値を求める．
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[out] val_list 関数値を格納するリスト
+  ///
+  /// val_list[pos] に eval(rv_mat, pos) の値が入る．
+  /// 出力ビットごとに全行をまとめて分類する．
+  void
+  eval_all(const RvMatrix& rv_mat,
+	   vector<ymuint>& val_list) const;
+
   /// @brief 内容を表示する．
   /// @param[in] s 出力先のストリーム
   void
   dump(ostream& s) const;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief コピーコンストラクタは禁止
+  SigFunc(const SigFunc& src);
+
+  /// @brief 代入演算子は禁止
+  const SigFunc&
+  operator=(const SigFunc& src);
+
+  /// @brief 出力ビットの変数を返す．
+  /// @param[in] pos 出力ビット ( 0 <= pos < output_width() )
+  Variable
+  var(ymuint pos) const;
+
+  /// @brief 疎な表現を用意する．
+  void
+  init_sparse();
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 変数のリスト
-  vector<Variable> mVarList;
+  // 変数の表
+  const VarTable* mVarTable;
+
+  // 自前の変数の表
+  // 表を共有している場合は nullptr
+  VarTable* mOwnTable;
+
+  // 変数の番号のリスト
+  vector<ymuint> mIdList;
+
+  // 疎な表現のリスト
+  // mRowSparse[i] か mColumnSparse[i] が true の時のみ意味を持つ．
+  vector<SparseVariable> mSparseList;
+
+  // eval() で疎な表現を用いるかどうかを表す配列
+  vector<bool> mRowSparse;
+
+  // eval_all() で疎な表現を用いるかどうかを表す配列
+  vector<bool> mColumnSparse;
 
 };
 
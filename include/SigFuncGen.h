@@ -10,7 +10,7 @@
 
 
 #include "igf.h"
-#include "ym/RandGen.h"
+#include "RandStream.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -37,6 +37,13 @@ public:
   // 外部インターフェイス
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 乱数の系列を設定する．
+  /// @param[in] rs 乱数の系列
+  ///
+  /// init() の前に呼ぶ必要がある．
+  void
+  set_rand_stream(const RandStream& rs);
+
   /// @brief 初期化を行う．
   /// @param[in] rv_list 登録ベクタのリスト
   /// @param[in] var_list 変数のリスト
@@ -87,14 +94,14 @@ private:
     init(const vector<const RegVect*>& rv_list,
 	 const vector<Variable>& var_list,
 	 ymuint width,
-	 RandGen& rg1);
+	 RandStream& rg1);
 
     /// @brief 次の状態に遷移する．
     /// @param[in] rv_list 登録ベクタのリスト
     void
     next_move(const vector<const RegVect*>& rv_list,
-	      RandGen& rg1,
-	      RandGen& rg2);
+	      RandStream& rg1,
+	      RandStream& rg2);
 
     /// @brief 現在の状態から SigFunc を生成する．
     SigFunc*
@@ -107,11 +114,11 @@ private:
     //////////////////////////////////////////////////////////////////////
 
     /// @brief 変数をランダムに選ぶ．
-    /// @param[in] rg 乱数発生器
+    /// @param[in] rg 乱数の系列
     ///
     /// 重複を避けるために選ばれた変数は mCandList から取り除かれる．
     Variable
-    choose_var(RandGen& rg);
+    choose_var(RandStream& rg);
 
 
   private:
@@ -137,11 +144,14 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 変数選択用の乱数発生器
-  RandGen mRgChoose;
+  // 元になる乱数の系列
+  RandStream mRandStream;
+
+  // 変数選択用の乱数の系列
+  RandStream mRgChoose;
 
-  // 受容/棄却を決めるための乱数発生器
-  RandGen mRgAccept;
+  // 受容/棄却を決めるための乱数の系列
+  RandStream mRgAccept;
 
   // 登録ベクタのリスト
   vector<const RegVect*> mRvList;
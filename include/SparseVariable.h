@@ -0,0 +1,135 @@
+#ifndef SPARSEVARIABLE_H
+#define SPARSEVARIABLE_H
+
+/// @file SparseVariable.h
+/// @brief SparseVariable のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class SparseVariable SparseVariable.h "SparseVariable.h"
+/// @brief 変数の疎な表現
+///
+/// Variable と同じく primary input の XOR を表すが，
+/// ビットベクタの代わりに含まれる変数番号のリスト(昇順)を持つ．
+/// 分類は該当するビットのみを集めて行うので，
+/// 計算量はビットベクタのブロック数ではなく次数(変数の数)に比例する．
+/// 入力数が多く次数の低い変数(RandHashGen の出力など)に向いている．
+///
+/// Variable からは暗黙に変換でき，dense() で Variable に戻せる．
+//////////////////////////////////////////////////////////////////////
+class SparseVariable
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  SparseVariable();
+
+  /// @brief Variable からの変換コンストラクタ
+  /// @param[in] var 変数
+  SparseVariable(const Variable& var);
+
+  /// @brief デストラクタ
+  ~SparseVariable();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数空間のサイズを返す．
+  ymuint
+  var_size() const;
+
+  /// @brief 次数(含まれる変数の数)を返す．
+  ymuint
+  degree() const;
+
+  /// @brief 変数番号を返す．
+  /// @param[in] pos 位置 ( 0 <= pos < degree() )
+  ymuint
+  vid(ymuint pos) const;
+
+  /// @brief Variable に変換する．
+  ///
+  /// 次数が 0 の場合はどのビットも立っていない変数を返す．
+  Variable
+  dense() const;
+
+  /// @brief 1行ずつの分類で疎な表現を用いたほうがよい時 true を返す．
+  /// @param[in] var 変数
+  ///
+  /// 1行あたりの計算量は疎な表現では次数，
+  /// 密な表現ではビットベクタのブロック数に比例するので
+  /// 次数がブロック数以下の時に疎な表現を用いる．
+  static
+  bool
+  is_preferred_row(const Variable& var);
+
+  /// @brief 列の XOR による全行の分類で疎な表現を用いたほうがよい時 true を返す．
+  /// @param[in] var 変数
+  ///
+  /// 行数を nv とすると，列の XOR は 次数 × nv / 64 ワードの読み書き，
+  /// 密な表現での行ごとの分類は nv × (ブロック数 + 1) 程度の手間となる．
+  /// 列の XOR は読み出しと書き戻しで2倍かかるとして比べる．
+  static
+  bool
+  is_preferred_column(const Variable& var);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数の総数
+  ymuint mVarNum;
+
+  // 変数番号のリスト
+  vector<ymuint> mVidList;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 変数空間のサイズを返す．
+inline
+ymuint
+SparseVariable::var_size() const
+{
+  return mVarNum;
+}
+
+// @brief 次数(含まれる変数の数)を返す．
+inline
+ymuint
+SparseVariable::degree() const
+{
+  return mVidList.size();
+}
+
+// @brief 変数番号を返す．
+// @param[in] pos 位置 ( 0 <= pos < degree() )
+inline
+ymuint
+SparseVariable::vid(ymuint pos) const
+{
+  ASSERT_COND( pos < degree() );
+  return mVidList[pos];
+}
+
+END_NAMESPACE_IGF
+
+#endif // SPARSEVARIABLE_H
@@ -11,22 +11,8 @@
 
 #include "igf.h"
 #include "Variable.h"
-#include "ym/HashSet.h"
+#include "VarTable.h"
 
-BEGIN_NAMESPACE_YM
-
-template<>
-struct
-HashFunc<nsIgf::Variable>
-{
-  ymuint
-  operator()(const nsIgf::Variable& key) const
-  {
-    return key.hash();
-  }
-};
-
-END_NAMESPACE_YM
 
 BEGIN_NAMESPACE_IGF
 
@@ -35,6 +21,14 @@ BEGIN_NAMESPACE_IGF
 /// @brief 一定数の変数を貯めておくデータ構造
 ///
 /// 溢れたら価値の最も低いものを捨てる．
+/// ヒープ木は価値の低いものが根となるように作るので，
+/// 根と比べるだけで新しい変数を入れるかどうかが分かる．
+///
+/// 変数の実体は VarTable に登録し，ヒープ木には番号のみを持つ．
+/// 重複のチェックは番号で行う．
+/// 表に登録するのはヒープ木に入れた変数のみで，
+/// 追い出された変数が溜まったら表を作り直す．
+/// そのため put() を呼ぶと以前の番号は無効となることがある．
 //////////////////////////////////////////////////////////////////////
 class VarPool
 {
@@ -59,9 +53,20 @@ public:
 
   /// @brief 変数を返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < size() )
-  const Variable&
+  Variable
   var(ymuint pos) const;
 
+  /// @brief 変数の番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < size() )
+  ///
+  /// 番号は var_table() 中のもの
+  ymuint
+  id(ymuint pos) const;
+
+  /// @brief 変数の表を返す．
+  const VarTable&
+  var_table() const;
+
   /// @brief 価値を返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < size() )
   double
@@ -76,6 +81,7 @@ public:
   /// @param[in] value 価値
   ///
   /// 容量オーバーのときは最も価値の低い変数を捨てる．
+  /// 新しい変数の価値が最も価値の低い変数以下の時は何もしない．
   void
   put(const Variable& var,
       double value);
@@ -93,7 +99,7 @@ private:
 
   struct Node
   {
-    Variable mVar;
+    ymuint mId;
     double mValue;
   };
 
@@ -108,6 +114,10 @@ private:
   void
   pop_min();
 
+  /// @brief 変数の表をヒープ木中の変数のみで作り直す．
+  void
+  compact();
+
   /// @brief 変数を適当な位置まで沈める．
   /// @param[in] pos 対象の変数の位置
   void
@@ -143,8 +153,11 @@ private:
   // ヒープ木中にある変数の数
   ymuint mVarNum;
 
-  // ハッシュテーブル
-  HashSet<Variable> mHashTable;
+  // 変数の表
+  VarTable mVarTable;
+
+  // 番号ごとにヒープ木中にあるかどうかを表す配列
+  vector<bool> mInHeap;
 
 };
 
@@ -164,11 +177,28 @@ VarPool::size() const
 // @brief 変数を返す．
 // @param[in] pos 位置番号 ( 0 <= pos < size() )
 inline
-const Variable&
+Variable
 VarPool::var(ymuint pos) const
+{
+  return mVarTable.var(id(pos));
+}
+
+// @brief 変数の番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < size() )
+inline
+ymuint
+VarPool::id(ymuint pos) const
 {
   ASSERT_COND( pos < size() );
-  return mHeap[pos].mVar;
+  return mHeap[pos].mId;
+}
+
+// @brief 変数の表を返す．
+inline
+const VarTable&
+VarPool::var_table() const
+{
+  return mVarTable;
 }
 
 // @brief 価値を返す．
@@ -198,10 +228,10 @@ int
 VarPool::compare(const Node& node1,
 		 const Node& node2)
 {
-  if ( node1.mValue > node2.mValue ) {
+  if ( node1.mValue < node2.mValue ) {
     return -1;
   }
-  else if ( node1.mValue < node2.mValue ) {
+  else if ( node1.mValue > node2.mValue ) {
     return 1;
   }
   else {
@@ -0,0 +1,224 @@
+#ifndef VARTABLE_H
+#define VARTABLE_H
+
+/// @file VarTable.h
+/// @brief VarTable のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class VarTable VarTable.h "VarTable.h"
+/// @brief 変数を共有して番号(ハンドル)を割り当てる表
+///
+/// 同じ内容の変数には同じ番号を割り当てる(hash consing)．
+/// 番号は 0 から始まる連続した32ビットの整数で，
+/// 変数のビットベクタは番号順に連続した領域に格納する．
+/// 同じ表から得られた番号どうしなら変数の等価比較は番号の比較となる．
+///
+/// 一度登録した変数は clear() するまで削除されない．
+/// 同じ表に登録する変数の総数(var_size())はすべて等しくなければならない．
+//////////////////////////////////////////////////////////////////////
+class VarTable
+{
+public:
+
+  /// @brief 存在しない番号を表す値
+  static
+  const ymuint kNoId = 0xFFFFFFFFU;
+
+  /// @brief コンストラクタ
+  /// @param[in] var_num 変数の総数
+  ///
+  /// var_num = 0 の場合は最初に登録された変数に合わせる．
+  explicit
+  VarTable(ymuint var_num = 0);
+
+  /// @brief コピーコンストラクタ
+  VarTable(const VarTable& src) = default;
+
+  /// @brief ムーブコンストラクタ
+  VarTable(VarTable&& src) = default;
+
+  /// @brief コピー代入演算子
+  VarTable&
+  operator=(const VarTable& src) = default;
+
+  /// @brief ムーブ代入演算子
+  ///
+  /// デストラクタを宣言すると暗黙のムーブが抑止されるので明示する．
+  VarTable&
+  operator=(VarTable&& src) = default;
+
+  /// @brief デストラクタ
+  ~VarTable();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を空にする．
+  /// @param[in] var_num 変数の総数
+  ///
+  /// それまでに割り当てた番号は無効となる．
+  void
+  clear(ymuint var_num = 0);
+
+  /// @brief 変数の総数を返す．
+  ymuint
+  var_size() const;
+
+  /// @brief 登録されている変数の数を返す．
+  ymuint
+  num() const;
+
+  /// @brief 変数を登録する．
+  /// @param[in] var 変数
+  /// @return 変数の番号を返す．
+  ///
+  /// 同じ内容の変数が登録済みならその番号を返す．
+  ymuint
+  intern(const Variable& var);
+
+  /// @brief ブロック列を変数として登録する．
+  /// @param[in] body ブロック列
+  /// @return 変数の番号を返す．
+  ///
+  /// body は Variable::raw_data() と同じ形式で
+  /// (var_size() + 63) / 64 個のブロックを持たなければならない．
+  /// var_size() より後ろのビットは 0 でなければならない．
+  ymuint
+  intern(const ymuint64* body);
+
+  /// @brief 2つの変数を合成した変数を登録する．
+  /// @param[in] id1, id2 変数の番号
+  /// @return 合成した変数の番号を返す．
+  ymuint
+  compose(ymuint id1,
+	  ymuint id2);
+
+  /// @brief 変数を探す．
+  /// @param[in] var 変数
+  /// @return 変数の番号を返す．
+  ///
+  /// 登録されていなければ kNoId を返す．
+  ymuint
+  find(const Variable& var) const;
+
+  /// @brief 変数を返す．
+  /// @param[in] id 変数の番号 ( 0 <= id < num() )
+  Variable
+  var(ymuint id) const;
+
+  /// @brief 変数のビットベクタの先頭を返す．
+  /// @param[in] id 変数の番号 ( 0 <= id < num() )
+  ///
+  /// Variable::raw_data() と同じ形式のブロックが
+  /// (var_size() + 63) / 64 個並んでいる．
+  /// 以降の登録で無効となることがある．
+  const ymuint64*
+  body(ymuint id) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ブロック列を登録する．
+  /// @param[in] body ブロック列
+  /// @return 番号を返す．
+  ymuint
+  intern_body(const ymuint64* body);
+
+  /// @brief ブロック列を探す．
+  /// @param[in] body ブロック列
+  /// @param[in] h body のハッシュ値
+  /// @return ハッシュ表の位置を返す．
+  ///
+  /// 見つからなかった場合には空きエントリの位置を返す．
+  ymuint64
+  lookup(const ymuint64* body,
+	 ymuint64 h) const;
+
+  /// @brief ハッシュ表を確保する．
+  /// @param[in] size サイズ(2のべき乗)
+  void
+  alloc_table(ymuint64 size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 変数の総数
+  ymuint mVarSize;
+
+  // 1変数あたりのブロック数
+  ymuint mBlockSize;
+
+  // ビットベクタの本体
+  // 番号 id の変数は mBody[id * mBlockSize] から始まる．
+  vector<ymuint64> mBody;
+
+  // 番号ごとのハッシュ値
+  vector<ymuint64> mHashArray;
+
+  // ハッシュ表
+  // 空きエントリは kNoId
+  vector<ymuint> mTable;
+
+  // ハッシュ表のサイズ - 1
+  ymuint64 mMask;
+
+  // 作業領域
+  // find() でも用いるので mutable にしておく．
+  mutable
+  vector<ymuint64> mTmpBody;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 変数の総数を返す．
+inline
+ymuint
+VarTable::var_size() const
+{
+  return mVarSize;
+}
+
+// @brief 登録されている変数の数を返す．
+inline
+ymuint
+VarTable::num() const
+{
+  return mHashArray.size();
+}
+
+// @brief 変数のビットベクタの先頭を返す．
+// @param[in] id 変数の番号 ( 0 <= id < num() )
+inline
+const ymuint64*
+VarTable::body(ymuint id) const
+{
+  ASSERT_COND( id < num() );
+  return mBody.data() + static_cast<ymuint64>(id) * mBlockSize;
+}
+
+END_NAMESPACE_IGF
+
+#endif // VARTABLE_H
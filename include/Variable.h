@@ -25,11 +25,22 @@ BEGIN_NAMESPACE_IGF
 ///
 /// コンストラクタではプライマリ変数しか作れない．
 /// 合成変数を作るには合成演算を用いる．
+///
+/// 変数の総数が kInlineSize 以下の場合にはビットベクタを
+/// オブジェクト内の領域に持つのでメモリの確保は行わない．
+/// それを超える場合のみヒープ上に確保する．
 //////////////////////////////////////////////////////////////////////
 class Variable
 {
+  friend class VarTable;
+  friend class CombGen;
+
 public:
 
+  /// @brief 内部の領域に保持できる変数の総数の最大値
+  static
+  const ymuint kInlineSize = 128;
+
   /// @brief 空のコンストラクタ
   Variable();
 
@@ -45,11 +56,24 @@ public:
   /// @param[in] src コピー元のオブジェクト
   Variable(const Variable& src);
 
+  /// @brief ムーブコンストラクタ
+  /// @param[in] src ムーブ元のオブジェクト
+  ///
+  /// src は空の変数となる．
+  Variable(Variable&& src) noexcept;
+
   /// @brief 代入演算子
   /// @param[in] src コピー元のオブジェクト
   const Variable&
   operator=(const Variable& src);
 
+  /// @brief ムーブ代入演算子
+  /// @param[in] src ムーブ元のオブジェクト
+  ///
+  /// src は空の変数となる．
+  const Variable&
+  operator=(Variable&& src) noexcept;
+
   /// @brief デストラクタ
   ~Variable();
 
@@ -75,6 +99,10 @@ public:
   vector<ymuint>
   vid_list() const;
 
+  /// @brief 次数(含まれる変数の数)を返す．
+  ymuint
+  degree() const;
+
   /// @brief ビットベクタの生データを返す．
   /// @param[in] pos ブロック番号
   ymuint64
@@ -99,9 +127,41 @@ public:
   ///
   /// 価値はこの変数で区別されるベクタ対の個数の
   /// 理想値に対する割合のこと．
+  /// ベクタを一つずつ分類するので，RvMgr のベクタに対しては
+  /// RvMgr::matrix() を用いる value(const RvMatrix&) の方が速い．
   double
   value(const vector<const RegVect*>& rv_list) const;
 
+  /// @brief ベクタ集合に対する価値を計算する．
+  /// @param[in] rv_mat ベクタの行列
+  /// @return 価値を返す．
+  ///
+  /// value(const vector<const RegVect*>&) と同じ値を
+  /// 連続領域の走査で求める．
+  double
+  value(const RvMatrix& rv_mat) const;
+
+  /// @brief 分類結果から価値を計算する．
+  /// @param[in] n0 0 に分類されたベクタ数
+  /// @param[in] n1 1 に分類されたベクタ数
+  ///
+  /// value() と同じ式で計算する．
+  static
+  double
+  calc_value(ymuint64 n0,
+	     ymuint64 n1);
+
+  /// @brief 複数の変数による分類の同時分布から価値を計算する．
+  /// @param[in] hist 同時分布(要素数は 2 のべき乗)
+  ///
+  /// 価値とは区別できる要素対の数を理想的な値で割ったもの．
+  /// 変数の数を t，ベクタ数を nv とすると理想的な値は
+  /// nv^2 (2^t - 1) / 2^(t + 1) となる．
+  /// hist が2要素なら calc_value(hist[0], hist[1]) と同じ．
+  static
+  double
+  calc_value(const vector<ymuint64>& hist);
+
   /// @brief 等価比較
   /// @param[in] right オペランド
   /// @return 等しい時 true を返す．
@@ -123,6 +183,14 @@ private:
   // 内部で用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief ビットベクタを指定したコンストラクタ
+  /// @param[in] body ブロック列((var_num + 63) / 64 個)
+  /// @param[in] var_num 変数の総数
+  ///
+  /// raw_data() の内容から変数を復元する．VarTable と CombGen が用いる．
+  Variable(const ymuint64* body,
+	   ymuint var_num);
+
   /// @brief ビットベクタのブロック数を返す．
   ymuint
   nblk() const;
@@ -139,6 +207,23 @@ private:
   ymuint
   sft(ymuint vid);
 
+  /// @brief mVarNum に合わせてビットベクタの領域を用意する．
+  ///
+  /// 内容は初期化しない．
+  void
+  alloc_body();
+
+  /// @brief ビットベクタの領域を解放する．
+  void
+  free_body();
+
+  /// @brief src の内容を奪う．
+  /// @param[in] src ムーブ元のオブジェクト
+  ///
+  /// 自身の領域は解放済みであること．
+  void
+  steal(Variable& src);
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -149,8 +234,12 @@ private:
   ymuint mVarNum;
 
   // 変数を表すビットベクタ
+  // mInlineBody を指すかヒープ上の領域を指す．
   ymuint64* mBitVect;
 
+  // 内部の領域
+  ymuint64 mInlineBody[kInlineSize / 64];
+
 };
 
 /// @relates Variable
@@ -45,8 +45,14 @@ BEGIN_NAMESPACE_IGF
 
 class RegVect;
 class RvMgr;
+class RvStream;
+class RvMatrix;
 
 class Variable;
+class SparseVariable;
+class VarTable;
+class VarPool;
+class RandStream;
 class SigFunc;
 class FuncVect;
 
@@ -0,0 +1,167 @@
+#ifndef FIXEDVARIABLE_H
+#define FIXEDVARIABLE_H
+
+/// @file FixedVariable.h
+/// @brief FixedVariable のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class FixedVariable FixedVariable.h "FixedVariable.h"
+/// @brief ブロック数をテンプレート引数で固定した分類用の変数
+///
+/// Variable::raw_data() のブロック列(マスク)をコピーして保持する．
+/// ブロック数がコンパイル時に決まるので分類のループは完全に
+/// 展開される．カーネル関数の内部でのみ用いる．
+///
+/// NBLK = 0 の場合は実行時にブロック数を決める汎用版となる．
+//////////////////////////////////////////////////////////////////////
+template<ymuint NBLK>
+class FixedVariable
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] mask マスクのブロック列(NBLK 個)
+  /// @param[in] nblk ブロック数(NBLK と等しくなければならない)
+  FixedVariable(const ymuint64* mask,
+		ymuint nblk)
+  {
+    ASSERT_COND( nblk == NBLK );
+    for (ymuint i = 0; i < NBLK; ++ i) {
+      mBody[i] = mask[i];
+    }
+  }
+
+  /// @brief ブロック数を返す．
+  ymuint
+  nblk() const
+  {
+    return NBLK;
+  }
+
+  /// @brief マスクのブロックを返す．
+  /// @param[in] pos ブロック番号 ( 0 <= pos < nblk() )
+  ymuint64
+  mask(ymuint pos) const
+  {
+    return mBody[pos];
+  }
+
+  /// @brief 行との AND の XOR をとる．
+  /// @param[in] row 行のブロックの先頭
+  ///
+  /// 結果のパリティが分類結果となる．
+  ymuint64
+  and_xor(const ymuint64* row) const
+  {
+    ymuint64 tmp = 0ULL;
+    for (ymuint i = 0; i < NBLK; ++ i) {
+      tmp ^= row[i] & mBody[i];
+    }
+    return tmp;
+  }
+
+  /// @brief 行を分類する．
+  /// @param[in] row 行のブロックの先頭
+  /// @return 0 か 1 を返す．
+  ymuint
+  classify(const ymuint64* row) const
+  {
+    return __builtin_parityll(and_xor(row));
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // マスクのブロック列
+  ymuint64 mBody[NBLK];
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class FixedVariable<0> FixedVariable.h "FixedVariable.h"
+/// @brief ブロック数を実行時に決める汎用版
+//////////////////////////////////////////////////////////////////////
+template<>
+class FixedVariable<0>
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] mask マスクのブロック列(nblk 個)
+  /// @param[in] nblk ブロック数
+  ///
+  /// mask の内容はコピーしないので呼び出し側で保持しておく必要がある．
+  FixedVariable(const ymuint64* mask,
+		ymuint nblk) :
+    mNblk(nblk),
+    mBody(mask)
+  {
+  }
+
+  /// @brief ブロック数を返す．
+  ymuint
+  nblk() const
+  {
+    return mNblk;
+  }
+
+  /// @brief マスクのブロックを返す．
+  /// @param[in] pos ブロック番号 ( 0 <= pos < nblk() )
+  ymuint64
+  mask(ymuint pos) const
+  {
+    return mBody[pos];
+  }
+
+  /// @brief 行との AND の XOR をとる．
+  /// @param[in] row 行のブロックの先頭
+  ymuint64
+  and_xor(const ymuint64* row) const
+  {
+    ymuint64 tmp = 0ULL;
+    for (ymuint i = 0; i < mNblk; ++ i) {
+      tmp ^= row[i] & mBody[i];
+    }
+    return tmp;
+  }
+
+  /// @brief 行を分類する．
+  /// @param[in] row 行のブロックの先頭
+  /// @return 0 か 1 を返す．
+  ymuint
+  classify(const ymuint64* row) const
+  {
+    return __builtin_parityll(and_xor(row));
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ブロック数
+  ymuint mNblk;
+
+  // マスクのブロック列
+  const ymuint64* mBody;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // FIXEDVARIABLE_H
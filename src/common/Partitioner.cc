@@ -9,6 +9,7 @@
 
 #include "Partitioner.h"
 #include "SigFunc.h"
+#include "RvMatrix.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -39,6 +40,26 @@ Partitioner::cf_partition(const vector<const RegVect*>& vect_list,
 			  const vector<const SigFunc*>& sigfunc_list,
 			  vector<ymuint>& mapping)
 {
+  RvMatrix rv_mat(vect_list);
+  return cf_partition(vect_list, rv_mat, sigfunc_list, mapping);
+}
+
+// @brief ベクタを分割する．
+// @param[in] vect_list ベクタのリスト
+// @param[in] rv_mat vect_list から作ったベクタの行列
+// @param[in] sigfunc_list シグネチャ関数のリスト
+// @param[out] mapping 個々のベクタの割当結果を入れる配列
+// @return 分割が成功したら true を返し，割当結果を mapping に入れる．
+//
+// rv_mat の行は vect_list と同じ順でなければならない．
+bool
+Partitioner::cf_partition(const vector<const RegVect*>& vect_list,
+			  const RvMatrix& rv_mat,
+			  const vector<const SigFunc*>& sigfunc_list,
+			  vector<ymuint>& mapping)
+{
+  ASSERT_COND( rv_mat.vect_num() == vect_list.size() );
+
   // スロットの情報を初期化する．
   ymuint nb = sigfunc_list.size();
   mSlotArray.clear();
@@ -58,8 +79,20 @@ Partitioner::cf_partition(const vector<const RegVect*>& vect_list,
     }
   }
 
-  // ベクタの情報を初期化する．
+  // 各ベクタのシグネチャをあらかじめ求めておく．
+  // 割当の探索中は同じベクタのシグネチャが何度も参照される．
   ymuint nv = vect_list.size();
+  mSigArray.clear();
+  mSigArray.resize(static_cast<ymuint64>(nv) * nb);
+  vector<ymuint> val_list;
+  for (ymuint j = 0; j < nb; ++ j) {
+    sigfunc_list[j]->eval_all(rv_mat, val_list);
+    for (ymuint i = 0; i < nv; ++ i) {
+      mSigArray[static_cast<ymuint64>(i) * nb + j] = val_list[i];
+    }
+  }
+
+  // ベクタの情報を初期化する．
   mVectArray.clear();
   mVectArray.resize(nv);
   mapping.clear();
@@ -69,6 +102,7 @@ Partitioner::cf_partition(const vector<const RegVect*>& vect_list,
     const RegVect* v = vect_list[i];
     VectInfo* vi = &mVectArray[i];
     vi->mVect = v;
+    vi->mPos = i;
     vi->mCurSlot = nullptr;
     vi->mSrc = nullptr;
     vi->mMark = false;
@@ -83,7 +117,7 @@ Partitioner::cf_partition(const vector<const RegVect*>& vect_list,
       bool found = false;
       vector<VectInfo*> tmp_vect_list;
       for (ymuint j = 0; j < nb; ++ j) {
-	ymuint sig = sigfunc_list[j]->eval(vi1->mVect);
+	ymuint sig = mSigArray[static_cast<ymuint64>(vi1->mPos) * nb + j];
 	Slot* slot = &mSlotArray[j][sig];
 	if ( slot->mCurVect == nullptr ) {
 	  // 空いていた．
@@ -0,0 +1,121 @@
+
+/// @file RvHash.cc
+/// @brief RvHash の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RvHash.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス RvHash
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] nblk ブロック数
+// @param[in] size 予想される要素数
+RvHash::RvHash(ymuint nblk,
+	       ymuint64 size) :
+  mBlockSize(nblk),
+  mTable(nullptr),
+  mNum(0),
+  mProbeNum(0),
+  mProbeTotal(0),
+  mProbeMax(0)
+{
+  // 負荷率が 1/2 以下になるようにする．
+  ymuint64 table_size = 1024;
+  while ( table_size < size * 2 ) {
+    table_size <<= 1;
+  }
+  alloc_table(table_size);
+}
+
+// @brief デストラクタ
+RvHash::~RvHash()
+{
+  delete [] mTable;
+}
+
+// @brief 要素を追加する．
+// @param[in] body ブロック列
+// @param[in] h body のハッシュ値
+// @retval true 追加した．
+// @retval false 同じ内容の要素がすでに存在した．
+bool
+RvHash::add(const ymuint64* body,
+	    ymuint64 h)
+{
+  if ( mNum >= mNextLimit ) {
+    // 表を拡張する．
+    Cell* old_table = mTable;
+    ymuint64 old_size = mTableSize;
+    alloc_table(old_size * 2);
+    for (ymuint64 i = 0; i < old_size; ++ i) {
+      const Cell& cell = old_table[i];
+      if ( cell.mBody != nullptr ) {
+	ymuint64 pos = cell.mHash & mMask;
+	while ( mTable[pos].mBody != nullptr ) {
+	  pos = (pos + 1) & mMask;
+	}
+	mTable[pos] = cell;
+      }
+    }
+    delete [] old_table;
+  }
+
+  ymuint64 pos = h & mMask;
+  ymuint64 probe = 1;
+  for ( ; ; ++ probe, pos = (pos + 1) & mMask) {
+    Cell& cell = mTable[pos];
+    if ( cell.mBody == nullptr ) {
+      // 空きエントリに追加する．
+      cell.mHash = h;
+      cell.mBody = body;
+      ++ mNum;
+      break;
+    }
+    if ( cell.mHash == h ) {
+      bool found = true;
+      for (ymuint i = 0; i < mBlockSize; ++ i) {
+	if ( cell.mBody[i] != body[i] ) {
+	  found = false;
+	  break;
+	}
+      }
+      if ( found ) {
+	break;
+      }
+    }
+  }
+
+  ++ mProbeNum;
+  mProbeTotal += probe;
+  if ( mProbeMax < probe ) {
+    mProbeMax = probe;
+  }
+
+  return mTable[pos].mBody == body;
+}
+
+// @brief ハッシュ表を確保する．
+// @param[in] size サイズ(2のべき乗)
+void
+RvHash::alloc_table(ymuint64 size)
+{
+  mTableSize = size;
+  mMask = size - 1;
+  mNextLimit = size / 2;
+  mTable = new Cell[size];
+  for (ymuint64 i = 0; i < size; ++ i) {
+    mTable[i].mHash = 0ULL;
+    mTable[i].mBody = nullptr;
+  }
+}
+
+END_NAMESPACE_IGF
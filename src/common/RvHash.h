@@ -0,0 +1,204 @@
+#ifndef RVHASH_H
+#define RVHASH_H
+
+/// @file RvHash.h
+/// @brief RvHash のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class RvHash RvHash.h "RvHash.h"
+/// @brief 登録ベクタの重複チェック用のハッシュ表
+///
+/// ブロック列(RegVect::mBody と同じ形式)へのポインタを要素とする
+/// 線形探索のオープンアドレス法のハッシュ表．
+/// ブロック列の実体は呼び出し側が保持しておく必要がある．
+/// 要素の削除はできない．
+///
+/// 探索の際に比較したエントリ数(プローブ長)の統計をとる．
+//////////////////////////////////////////////////////////////////////
+class RvHash
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] nblk ブロック数
+  /// @param[in] size 予想される要素数
+  RvHash(ymuint nblk,
+	 ymuint64 size = 0);
+
+  /// @brief デストラクタ
+  ~RvHash();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ブロック列のハッシュ値を求める．
+  /// @param[in] body ブロック列
+  /// @param[in] nblk ブロック数
+  ///
+  /// 各ブロックを 64 ビットの乗算と xorshift で混ぜ合わせる．
+  static
+  ymuint64
+  hash(const ymuint64* body,
+       ymuint nblk);
+
+  /// @brief 要素を追加する．
+  /// @param[in] body ブロック列
+  /// @param[in] h body のハッシュ値
+  /// @retval true 追加した．
+  /// @retval false 同じ内容の要素がすでに存在した．
+  bool
+  add(const ymuint64* body,
+      ymuint64 h);
+
+  /// @brief 要素数を返す．
+  ymuint64
+  num() const;
+
+  /// @brief 探索回数を返す．
+  ymuint64
+  probe_num() const;
+
+  /// @brief プローブ長の総和を返す．
+  ymuint64
+  probe_total() const;
+
+  /// @brief プローブ長の最大値を返す．
+  ymuint64
+  probe_max() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられるデータ構造
+  //////////////////////////////////////////////////////////////////////
+
+  // エントリ
+  struct Cell
+  {
+    // ハッシュ値
+    ymuint64 mHash;
+
+    // ブロック列
+    // 空きエントリの場合は nullptr
+    const ymuint64* mBody;
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ハッシュ表を確保する．
+  /// @param[in] size サイズ(2のべき乗)
+  void
+  alloc_table(ymuint64 size);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ブロック数
+  ymuint mBlockSize;
+
+  // ハッシュ表のサイズ
+  ymuint64 mTableSize;
+
+  // ハッシュ表のサイズ - 1
+  ymuint64 mMask;
+
+  // ハッシュ表
+  Cell* mTable;
+
+  // 要素数
+  ymuint64 mNum;
+
+  // 拡張する要素数
+  ymuint64 mNextLimit;
+
+  // 探索回数
+  ymuint64 mProbeNum;
+
+  // プローブ長の総和
+  ymuint64 mProbeTotal;
+
+  // プローブ長の最大値
+  ymuint64 mProbeMax;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief ブロック列のハッシュ値を求める．
+// @param[in] body ブロック列
+// @param[in] nblk ブロック数
+inline
+ymuint64
+RvHash::hash(const ymuint64* body,
+	     ymuint nblk)
+{
+  ymuint64 h = 0x9E3779B97F4A7C15ULL;
+  for (ymuint i = 0; i < nblk; ++ i) {
+    h ^= body[i];
+    h ^= (h >> 30);
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= (h >> 27);
+    h *= 0x94D049BB133111EBULL;
+    h ^= (h >> 31);
+  }
+  return h;
+}
+
+// @brief 要素数を返す．
+inline
+ymuint64
+RvHash::num() const
+{
+  return mNum;
+}
+
+// @brief 探索回数を返す．
+inline
+ymuint64
+RvHash::probe_num() const
+{
+  return mProbeNum;
+}
+
+// @brief プローブ長の総和を返す．
+inline
+ymuint64
+RvHash::probe_total() const
+{
+  return mProbeTotal;
+}
+
+// @brief プローブ長の最大値を返す．
+inline
+ymuint64
+RvHash::probe_max() const
+{
+  return mProbeMax;
+}
+
+END_NAMESPACE_IGF
+
+#endif // RVHASH_H
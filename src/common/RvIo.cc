@@ -0,0 +1,150 @@
+
+/// @file RvIo.cc
+/// @brief 登録ベクタの入出力用の下請け関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RvIo.h"
+#if defined(__SSE2__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_IGF
+
+// バイナリ形式のマジックナンバー
+const char rvb_magic[4] = { 'R', 'V', 'B', '1' };
+
+// @brief 数字を読み込む．
+// @param[inout] p 読み出し位置
+// @param[in] end 末尾
+//
+// 空白か行末で区切られる．
+ymuint
+rv_read_num(const char*& p,
+	    const char* end)
+{
+  ymuint ans = 0;
+  for ( ; p != end; ) {
+    char c = *p;
+    if ( c == '\n' ) {
+      return ans;
+    }
+    ++ p;
+    if ( c >= '0' && c <= '9' ) {
+      ans = ans * 10 + static_cast<ymuint>(c - '0');
+    }
+    if ( c == ' ' || c == '\0' ) {
+      return ans;
+    }
+  }
+  return ans;
+}
+
+BEGIN_NONAMESPACE
+
+// '0' と '1' からなる文字列をスカラー演算でビットベクタに変換する．
+// pos から n 文字目までを処理する．
+// 不正な文字があった場合にはその位置を返す．
+// そうでなければ n を返す．
+ymuint
+pack_scalar(const char* str,
+	    ymuint pos,
+	    ymuint n,
+	    ymuint64* body)
+{
+  for (ymuint j = pos; j < n; ++ j) {
+    char c = str[j];
+    if ( c == '1' ) {
+      body[j / 64] |= (1ULL << (j % 64));
+    }
+    else if ( c != '0' ) {
+      return j;
+    }
+  }
+  return n;
+}
+
+#if defined(__SSE2__)
+
+// 16文字ずつ SSE2 命令で変換する．
+// c | 1 == '1' なら c は '0' か '1' なので比較一回で検査できる．
+ymuint
+pack_sse2(const char* str,
+	  ymuint n,
+	  ymuint64* body)
+{
+  const __m128i c1 = _mm_set1_epi8('1');
+  const __m128i one = _mm_set1_epi8(1);
+  ymuint j = 0;
+  for ( ; j + 16 <= n; j += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + j));
+    ymuint ok = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(v, one), c1));
+    if ( ok != 0xFFFFU ) {
+      return j + __builtin_ctz(~ok);
+    }
+    ymuint64 bits = _mm_movemask_epi8(_mm_cmpeq_epi8(v, c1));
+    body[j / 64] |= (bits << (j % 64));
+  }
+  return pack_scalar(str, j, n, body);
+}
+
+#endif
+
+#if defined(__GNUC__) && defined(__x86_64__)
+
+// 32文字ずつ AVX2 命令で変換する．
+__attribute__((target("avx2")))
+ymuint
+pack_avx2(const char* str,
+	  ymuint n,
+	  ymuint64* body)
+{
+  const __m256i c1 = _mm256_set1_epi8('1');
+  const __m256i one = _mm256_set1_epi8(1);
+  ymuint j = 0;
+  for ( ; j + 32 <= n; j += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str + j));
+    ymuint32 ok = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_or_si256(v, one), c1));
+    if ( ok != 0xFFFFFFFFU ) {
+      return j + __builtin_ctz(~ok);
+    }
+    ymuint64 bits = static_cast<ymuint32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, c1)));
+    body[j / 64] |= (bits << (j % 64));
+  }
+  return pack_scalar(str, j, n, body);
+}
+
+#endif
+
+END_NONAMESPACE
+
+// @brief '0' と '1' からなる文字列をビットベクタに変換する．
+// @param[in] str 文字列の先頭
+// @param[in] n 文字数
+// @param[out] body 結果を格納するブロックの配列
+// @return 不正な文字があった場合にはその位置を，なければ n を返す．
+//
+// body はあらかじめ 0 に初期化されていなければならない．
+ymuint
+rv_pack_bits(const char* str,
+	     ymuint n,
+	     ymuint64* body)
+{
+#if defined(__GNUC__) && defined(__x86_64__)
+  static const bool use_avx2 = __builtin_cpu_supports("avx2");
+  if ( use_avx2 ) {
+    return pack_avx2(str, n, body);
+  }
+#endif
+#if defined(__SSE2__)
+  return pack_sse2(str, n, body);
+#else
+  return pack_scalar(str, 0, n, body);
+#endif
+}
+
+END_NAMESPACE_IGF
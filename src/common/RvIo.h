@@ -0,0 +1,71 @@
+#ifndef RVIO_H
+#define RVIO_H
+
+/// @file RvIo.h
+/// @brief 登録ベクタの入出力用の下請け関数のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @brief バイナリ形式(.rvb)のヘッダ
+///
+/// この後にベクタ数分のレコード(RegVect のメモリイメージ)が続く．
+//////////////////////////////////////////////////////////////////////
+struct RvbHeader
+{
+  // マジックナンバー
+  char mMagic[4];
+
+  // ベクタのビット長
+  ymuint32 mVectSize;
+
+  // ブロック数
+  ymuint32 mBlockSize;
+
+  // レコードのバイト数
+  ymuint32 mRecSize;
+
+  // ベクタ数
+  ymuint64 mNum;
+
+  // 予約
+  ymuint64 mReserved;
+};
+
+/// @brief バイナリ形式のマジックナンバー
+extern
+const char rvb_magic[4];
+
+/// @brief 数字を読み込む．
+/// @param[inout] p 読み出し位置
+/// @param[in] end 末尾
+///
+/// 空白か行末で区切られる．
+ymuint
+rv_read_num(const char*& p,
+	    const char* end);
+
+/// @brief '0' と '1' からなる文字列をビットベクタに変換する．
+/// @param[in] str 文字列の先頭
+/// @param[in] n 文字数
+/// @param[out] body 結果を格納するブロックの配列
+/// @return 不正な文字があった場合にはその位置を，なければ n を返す．
+///
+/// body はあらかじめ 0 に初期化されていなければならない．
+/// 実行環境に応じて AVX2/SSE2 命令を用いる．
+ymuint
+rv_pack_bits(const char* str,
+	     ymuint n,
+	     ymuint64* body);
+
+END_NAMESPACE_IGF
+
+#endif // RVIO_H
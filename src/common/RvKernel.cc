@@ -0,0 +1,796 @@
+
+/// @file RvKernel.cc
+/// @brief 登録ベクタの分類用のカーネル関数の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RvKernel.h"
+#include "FixedVariable.h"
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 結果のビットベクタを 0 に初期化する．
+inline
+void
+clear_bits(ymuint64 num,
+	   ymuint64* bits)
+{
+  ymuint64 nw = (num + 63) / 64;
+  for (ymuint64 i = 0; i < nw; ++ i) {
+    bits[i] = 0ULL;
+  }
+}
+
+// 行 [pos, num) をスカラー演算で分類する．
+// bits は初期化されているものとする．
+template<ymuint NBLK>
+inline
+void
+classify_tail(const ymuint64* body,
+	      ymuint64 stride,
+	      ymuint64 pos,
+	      ymuint64 num,
+	      const FixedVariable<NBLK>& var,
+	      ymuint64* bits)
+{
+  const ymuint64* row = body + pos * stride;
+  for ( ; pos < num; ++ pos, row += stride) {
+    bits[pos / 64] |= static_cast<ymuint64>(var.classify(row)) << (pos % 64);
+  }
+}
+
+// スカラー版の分類
+template<ymuint NBLK>
+void
+classify_scalar(const ymuint64* body,
+		ymuint64 stride,
+		ymuint nblk,
+		ymuint64 num,
+		const ymuint64* mask,
+		ymuint64* bits)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  clear_bits(num, bits);
+  classify_tail(body, stride, 0, num, var, bits);
+}
+
+// 64行分を分類したワードを作る．
+// 行 [pos, pos + n) の分類結果を下位ビットから並べる．
+template<ymuint NBLK>
+inline
+ymuint64
+classify_word(const ymuint64* body,
+	      ymuint64 stride,
+	      ymuint64 pos,
+	      ymuint n,
+	      const FixedVariable<NBLK>& var)
+{
+  const ymuint64* row = body + pos * stride;
+  ymuint64 word = 0ULL;
+  for (ymuint i = 0; i < n; ++ i, row += stride) {
+    word |= static_cast<ymuint64>(var.classify(row)) << i;
+  }
+  return word;
+}
+
+// 行ごとの分類と 1 の数え上げの本体
+template<ymuint NBLK>
+inline
+ymuint64
+count1_rows_body(const ymuint64* body,
+		 ymuint64 stride,
+		 ymuint nblk,
+		 ymuint64 num,
+		 const ymuint64* mask)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  ymuint64 c = 0;
+  const ymuint64* row = body;
+  for (ymuint64 i = 0; i < num; ++ i, row += stride) {
+    c += var.classify(row);
+  }
+  return c;
+}
+
+// 行ごとの分類とビットベクタとの XOR の本体
+template<ymuint NBLK>
+inline
+ymuint64
+xor_count_rows_body(const ymuint64* body,
+		    ymuint64 stride,
+		    ymuint nblk,
+		    ymuint64 num,
+		    const ymuint64* mask,
+		    const ymuint64* src,
+		    ymuint64* dst)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  ymuint64 c = 0;
+  ymuint64 nw = (num + 63) / 64;
+  for (ymuint64 w = 0; w < nw; ++ w) {
+    ymuint64 pos = w * 64;
+    ymuint n = num - pos < 64 ? num - pos : 64;
+    ymuint64 tmp = src[w] ^ classify_word(body, stride, pos, n, var);
+    dst[w] = tmp;
+    c += __builtin_popcountll(tmp);
+  }
+  return c;
+}
+
+// 64行分の分類結果のワードから同時分布を数える．
+//
+// AND/ANDN で 2^t 通りのパタンに対応するビットマスクを作って
+// それぞれの 1 の数を数える．valid の外のビットは数えない．
+inline
+void
+joint_count_word(const ymuint64* word,
+		 ymuint t,
+		 ymuint64 valid,
+		 ymuint64* hist)
+{
+  ymuint64 leaf[1U << kRvJointMax];
+  leaf[0] = valid;
+  for (ymuint v = 0; v < t; ++ v) {
+    ymuint64 b = word[v];
+    ymuint n = 1U << v;
+    for (ymuint p = 0; p < n; ++ p) {
+      ymuint64 x = leaf[p];
+      leaf[p + n] = x & b;
+      leaf[p] = x & ~b;
+    }
+  }
+  ymuint np = 1U << t;
+  for (ymuint p = 0; p < np; ++ p) {
+    hist[p] += __builtin_popcountll(leaf[p]);
+  }
+}
+
+// 行ごとの分類と同時分布の数え上げの本体
+template<ymuint NBLK>
+inline
+void
+joint_count_rows_body(const ymuint64* body,
+		      ymuint64 stride,
+		      ymuint nblk,
+		      ymuint64 num,
+		      const ymuint64* const* mask_list,
+		      ymuint t,
+		      ymuint64* hist)
+{
+  ymuint np = 1U << t;
+  for (ymuint p = 0; p < np; ++ p) {
+    hist[p] = 0;
+  }
+  ymuint64 word[kRvJointMax];
+  ymuint64 nw = (num + 63) / 64;
+  for (ymuint64 w = 0; w < nw; ++ w) {
+    ymuint64 pos = w * 64;
+    ymuint n = num - pos < 64 ? num - pos : 64;
+    for (ymuint v = 0; v < t; ++ v) {
+      FixedVariable<NBLK> var(mask_list[v], nblk);
+      word[v] = classify_word(body, stride, pos, n, var);
+    }
+    ymuint64 valid = n < 64 ? (1ULL << n) - 1ULL : ~0ULL;
+    joint_count_word(word, t, valid, hist);
+  }
+}
+
+// スカラー版の行ごとの分類と 1 の数え上げ
+template<ymuint NBLK>
+ymuint64
+count1_rows_scalar(const ymuint64* body,
+		   ymuint64 stride,
+		   ymuint nblk,
+		   ymuint64 num,
+		   const ymuint64* mask)
+{
+  return count1_rows_body<NBLK>(body, stride, nblk, num, mask);
+}
+
+// スカラー版の行ごとの分類とビットベクタとの XOR
+template<ymuint NBLK>
+ymuint64
+xor_count_rows_scalar(const ymuint64* body,
+		      ymuint64 stride,
+		      ymuint nblk,
+		      ymuint64 num,
+		      const ymuint64* mask,
+		      const ymuint64* src,
+		      ymuint64* dst)
+{
+  return xor_count_rows_body<NBLK>(body, stride, nblk, num, mask, src, dst);
+}
+
+// スカラー版の行ごとの分類と同時分布の数え上げ
+template<ymuint NBLK>
+void
+joint_count_rows_scalar(const ymuint64* body,
+			ymuint64 stride,
+			ymuint nblk,
+			ymuint64 num,
+			const ymuint64* const* mask_list,
+			ymuint t,
+			ymuint64* hist)
+{
+  joint_count_rows_body<NBLK>(body, stride, nblk, num, mask_list, t, hist);
+}
+
+// スカラー版の 1 の数え上げ
+ymuint64
+count_scalar(const ymuint64* bits,
+	     ymuint64 n)
+{
+  ymuint64 c = 0;
+  for (ymuint64 i = 0; i < n; ++ i) {
+    c += __builtin_popcountll(bits[i]);
+  }
+  return c;
+}
+
+// スカラー版の XOR と数え上げ
+ymuint64
+xor_count_scalar(const ymuint64* src1,
+		 const ymuint64* src2,
+		 ymuint64* dst,
+		 ymuint64 n)
+{
+  ymuint64 c = 0;
+  for (ymuint64 i = 0; i < n; ++ i) {
+    ymuint64 tmp = src1[i] ^ src2[i];
+    dst[i] = tmp;
+    c += __builtin_popcountll(tmp);
+  }
+  return c;
+}
+
+// 同時分布の数え上げの本体
+//
+// 1ブロック(64行)ごとに AND/ANDN で 2^t 通りのパタンに
+// 対応するビットマスクを作ってそれぞれの 1 の数を数える．
+// 最後のブロックの余りのビットは数えない．
+inline
+void
+joint_count_body(const ymuint64* const* bits_list,
+		 ymuint t,
+		 ymuint64 num,
+		 ymuint64* hist)
+{
+  ymuint np = 1U << t;
+  for (ymuint p = 0; p < np; ++ p) {
+    hist[p] = 0;
+  }
+  ymuint64 word[kRvJointMax];
+  ymuint64 nblk = (num + 63) / 64;
+  for (ymuint64 i = 0; i < nblk; ++ i) {
+    ymuint64 valid = ~0ULL;
+    if ( i == nblk - 1 && (num % 64) != 0 ) {
+      valid = (1ULL << (num % 64)) - 1ULL;
+    }
+    for (ymuint v = 0; v < t; ++ v) {
+      word[v] = bits_list[v][i];
+    }
+    joint_count_word(word, t, valid, hist);
+  }
+}
+
+// スカラー版の同時分布の数え上げ
+void
+joint_count_scalar(const ymuint64* const* bits_list,
+		   ymuint t,
+		   ymuint64 num,
+		   ymuint64* hist)
+{
+  joint_count_body(bits_list, t, num, hist);
+}
+
+#if defined(__GNUC__) && defined(__x86_64__)
+
+// POPCNT 命令を用いた分類
+template<ymuint NBLK>
+__attribute__((target("popcnt")))
+void
+classify_popcnt(const ymuint64* body,
+		ymuint64 stride,
+		ymuint nblk,
+		ymuint64 num,
+		const ymuint64* mask,
+		ymuint64* bits)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  clear_bits(num, bits);
+  classify_tail(body, stride, 0, num, var, bits);
+}
+
+// POPCNT 命令を用いた行ごとの分類と 1 の数え上げ
+template<ymuint NBLK>
+__attribute__((target("popcnt")))
+ymuint64
+count1_rows_popcnt(const ymuint64* body,
+		   ymuint64 stride,
+		   ymuint nblk,
+		   ymuint64 num,
+		   const ymuint64* mask)
+{
+  return count1_rows_body<NBLK>(body, stride, nblk, num, mask);
+}
+
+// POPCNT 命令を用いた行ごとの分類とビットベクタとの XOR
+template<ymuint NBLK>
+__attribute__((target("popcnt")))
+ymuint64
+xor_count_rows_popcnt(const ymuint64* body,
+		      ymuint64 stride,
+		      ymuint nblk,
+		      ymuint64 num,
+		      const ymuint64* mask,
+		      const ymuint64* src,
+		      ymuint64* dst)
+{
+  return xor_count_rows_body<NBLK>(body, stride, nblk, num, mask, src, dst);
+}
+
+// POPCNT 命令を用いた行ごとの分類と同時分布の数え上げ
+template<ymuint NBLK>
+__attribute__((target("popcnt")))
+void
+joint_count_rows_popcnt(const ymuint64* body,
+			ymuint64 stride,
+			ymuint nblk,
+			ymuint64 num,
+			const ymuint64* const* mask_list,
+			ymuint t,
+			ymuint64* hist)
+{
+  joint_count_rows_body<NBLK>(body, stride, nblk, num, mask_list, t, hist);
+}
+
+// POPCNT 命令を用いた 1 の数え上げ
+__attribute__((target("popcnt")))
+ymuint64
+count_popcnt(const ymuint64* bits,
+	     ymuint64 n)
+{
+  ymuint64 c = 0;
+  for (ymuint64 i = 0; i < n; ++ i) {
+    c += __builtin_popcountll(bits[i]);
+  }
+  return c;
+}
+
+// POPCNT 命令を用いた XOR と数え上げ
+__attribute__((target("popcnt")))
+ymuint64
+xor_count_popcnt(const ymuint64* src1,
+		 const ymuint64* src2,
+		 ymuint64* dst,
+		 ymuint64 n)
+{
+  ymuint64 c = 0;
+  for (ymuint64 i = 0; i < n; ++ i) {
+    ymuint64 tmp = src1[i] ^ src2[i];
+    dst[i] = tmp;
+    c += __builtin_popcountll(tmp);
+  }
+  return c;
+}
+
+// POPCNT 命令を用いた同時分布の数え上げ
+__attribute__((target("popcnt")))
+void
+joint_count_popcnt(const ymuint64* const* bits_list,
+		   ymuint t,
+		   ymuint64 num,
+		   ymuint64* hist)
+{
+  joint_count_body(bits_list, t, num, hist);
+}
+
+// AVX2 命令を用いた分類
+// 4行分のブロックを gather で集めて AND/XOR し，
+// シフトと XOR の畳み込みでパリティを求める．
+template<ymuint NBLK>
+__attribute__((target("avx2,popcnt")))
+void
+classify_avx2(const ymuint64* body,
+	      ymuint64 stride,
+	      ymuint nblk,
+	      ymuint64 num,
+	      const ymuint64* mask,
+	      ymuint64* bits)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  clear_bits(num, bits);
+  const __m256i idx = _mm256_set_epi64x(stride * 3, stride * 2, stride, 0);
+  ymuint64 pos = 0;
+  for ( ; pos + 4 <= num; pos += 4) {
+    const long long* row = reinterpret_cast<const long long*>(body + pos * stride);
+    __m256i acc = _mm256_setzero_si256();
+    for (ymuint b = 0; b < var.nblk(); ++ b) {
+      __m256i v = _mm256_i64gather_epi64(row + b, idx, 8);
+      __m256i m = _mm256_set1_epi64x(var.mask(b));
+      acc = _mm256_xor_si256(acc, _mm256_and_si256(v, m));
+    }
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 32));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 16));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 8));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 4));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 2));
+    acc = _mm256_xor_si256(acc, _mm256_srli_epi64(acc, 1));
+    ymuint64 m = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_slli_epi64(acc, 63)));
+    bits[pos / 64] |= m << (pos % 64);
+  }
+  classify_tail(body, stride, pos, num, var, bits);
+}
+
+// AVX-512 命令を用いた分類
+// 8行分のブロックを gather で集めて AND/XOR し，
+// VPOPCNTQ の最下位ビットをパリティとする．
+template<ymuint NBLK>
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+void
+classify_avx512(const ymuint64* body,
+		ymuint64 stride,
+		ymuint nblk,
+		ymuint64 num,
+		const ymuint64* mask,
+		ymuint64* bits)
+{
+  FixedVariable<NBLK> var(mask, nblk);
+  clear_bits(num, bits);
+  const __m512i idx = _mm512_set_epi64(stride * 7, stride * 6, stride * 5, stride * 4,
+				       stride * 3, stride * 2, stride, 0);
+  const __m512i one = _mm512_set1_epi64(1);
+  const __m512i zero = _mm512_setzero_si512();
+  ymuint64 pos = 0;
+  for ( ; pos + 8 <= num; pos += 8) {
+    const ymuint64* row = body + pos * stride;
+    __m512i acc = _mm512_setzero_si512();
+    for (ymuint b = 0; b < var.nblk(); ++ b) {
+      __m512i v = _mm512_mask_i64gather_epi64(zero, 0xFF, idx, row + b, 8);
+      __m512i m = _mm512_set1_epi64(var.mask(b));
+      acc = _mm512_xor_si512(acc, _mm512_and_si512(v, m));
+    }
+    __mmask8 k = _mm512_test_epi64_mask(_mm512_popcnt_epi64(acc), one);
+    bits[pos / 64] |= static_cast<ymuint64>(k) << (pos % 64);
+  }
+  classify_tail(body, stride, pos, num, var, bits);
+}
+
+// AVX-512 命令を用いた 1 の数え上げ
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+ymuint64
+count_avx512(const ymuint64* bits,
+	     ymuint64 n)
+{
+  __m512i acc = _mm512_setzero_si512();
+  ymuint64 i = 0;
+  for ( ; i + 8 <= n; i += 8) {
+    __m512i v = _mm512_loadu_si512(bits + i);
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  }
+  ymuint64 tmp[8];
+  _mm512_storeu_si512(tmp, acc);
+  ymuint64 c = 0;
+  for (ymuint j = 0; j < 8; ++ j) {
+    c += tmp[j];
+  }
+  for ( ; i < n; ++ i) {
+    c += __builtin_popcountll(bits[i]);
+  }
+  return c;
+}
+
+// AVX-512 命令を用いた XOR と数え上げ
+__attribute__((target("avx512f,avx512vpopcntdq,popcnt")))
+ymuint64
+xor_count_avx512(const ymuint64* src1,
+		 const ymuint64* src2,
+		 ymuint64* dst,
+		 ymuint64 n)
+{
+  __m512i acc = _mm512_setzero_si512();
+  ymuint64 i = 0;
+  for ( ; i + 8 <= n; i += 8) {
+    __m512i v = _mm512_xor_si512(_mm512_loadu_si512(src1 + i),
+				 _mm512_loadu_si512(src2 + i));
+    _mm512_storeu_si512(dst + i, v);
+    acc = _mm512_add_epi64(acc, _mm512_popcnt_epi64(v));
+  }
+  ymuint64 tmp[8];
+  _mm512_storeu_si512(tmp, acc);
+  ymuint64 c = 0;
+  for (ymuint j = 0; j < 8; ++ j) {
+    c += tmp[j];
+  }
+  for ( ; i < n; ++ i) {
+    ymuint64 tmp1 = src1[i] ^ src2[i];
+    dst[i] = tmp1;
+    c += __builtin_popcountll(tmp1);
+  }
+  return c;
+}
+
+#endif
+
+// 分類関数の型
+typedef void (*ClassifyFunc)(const ymuint64*, ymuint64, ymuint, ymuint64,
+			     const ymuint64*, ymuint64*);
+
+// 行ごとの分類と 1 の数え上げ関数の型
+typedef ymuint64 (*Count1RowsFunc)(const ymuint64*, ymuint64, ymuint, ymuint64,
+				   const ymuint64*);
+
+// 行ごとの分類とビットベクタとの XOR 関数の型
+typedef ymuint64 (*XorCountRowsFunc)(const ymuint64*, ymuint64, ymuint, ymuint64,
+				     const ymuint64*, const ymuint64*, ymuint64*);
+
+// 行ごとの分類と同時分布の数え上げ関数の型
+typedef void (*JointCountRowsFunc)(const ymuint64*, ymuint64, ymuint, ymuint64,
+				   const ymuint64* const*, ymuint, ymuint64*);
+
+// ブロック数を固定した分類関数を用意するブロック数の最大値
+// 64 ビットと 128 ビットのベクタがほとんどなので 2 までとする．
+const ymuint kFixedMax = 2;
+
+// カーネルの定義
+struct Kernel
+{
+  // 名前
+  const char* mName;
+
+  // 分類関数
+  // ブロック数が 1, 2 の特殊化版と汎用版を持つ．
+  ClassifyFunc mClassify[kFixedMax + 1];
+
+  // 数え上げ関数
+  ymuint64 (*mCount)(const ymuint64*, ymuint64);
+
+  // XOR と数え上げ関数
+  ymuint64 (*mXorCount)(const ymuint64*, const ymuint64*, ymuint64*, ymuint64);
+
+  // 同時分布の数え上げ関数
+  void (*mJointCount)(const ymuint64* const*, ymuint, ymuint64, ymuint64*);
+
+  // 行ごとの分類と 1 の数え上げ関数
+  // mClassify と同じくブロック数で特殊化版を選ぶ．
+  Count1RowsFunc mCount1Rows[kFixedMax + 1];
+
+  // 行ごとの分類とビットベクタとの XOR 関数
+  XorCountRowsFunc mXorCountRows[kFixedMax + 1];
+
+  // 行ごとの分類と同時分布の数え上げ関数
+  JointCountRowsFunc mJointCountRows[kFixedMax + 1];
+};
+
+// カーネルの表
+// 優先度の高い順に並べる．
+const Kernel kernel_table[] = {
+#if defined(__GNUC__) && defined(__x86_64__)
+  { "avx512",
+    { classify_avx512<0>, classify_avx512<1>, classify_avx512<2> },
+    count_avx512, xor_count_avx512, joint_count_popcnt,
+    { count1_rows_popcnt<0>, count1_rows_popcnt<1>, count1_rows_popcnt<2> },
+    { xor_count_rows_popcnt<0>, xor_count_rows_popcnt<1>, xor_count_rows_popcnt<2> },
+    { joint_count_rows_popcnt<0>, joint_count_rows_popcnt<1>, joint_count_rows_popcnt<2> } },
+  { "avx2",
+    { classify_avx2<0>, classify_avx2<1>, classify_avx2<2> },
+    count_popcnt, xor_count_popcnt, joint_count_popcnt,
+    { count1_rows_popcnt<0>, count1_rows_popcnt<1>, count1_rows_popcnt<2> },
+    { xor_count_rows_popcnt<0>, xor_count_rows_popcnt<1>, xor_count_rows_popcnt<2> },
+    { joint_count_rows_popcnt<0>, joint_count_rows_popcnt<1>, joint_count_rows_popcnt<2> } },
+  { "popcnt",
+    { classify_popcnt<0>, classify_popcnt<1>, classify_popcnt<2> },
+    count_popcnt, xor_count_popcnt, joint_count_popcnt,
+    { count1_rows_popcnt<0>, count1_rows_popcnt<1>, count1_rows_popcnt<2> },
+    { xor_count_rows_popcnt<0>, xor_count_rows_popcnt<1>, xor_count_rows_popcnt<2> },
+    { joint_count_rows_popcnt<0>, joint_count_rows_popcnt<1>, joint_count_rows_popcnt<2> } },
+#endif
+  { "scalar",
+    { classify_scalar<0>, classify_scalar<1>, classify_scalar<2> },
+    count_scalar, xor_count_scalar, joint_count_scalar,
+    { count1_rows_scalar<0>, count1_rows_scalar<1>, count1_rows_scalar<2> },
+    { xor_count_rows_scalar<0>, xor_count_rows_scalar<1>, xor_count_rows_scalar<2> },
+    { joint_count_rows_scalar<0>, joint_count_rows_scalar<1>, joint_count_rows_scalar<2> } }
+};
+
+const ymuint kernel_num = sizeof(kernel_table) / sizeof(Kernel);
+
+// カーネルが実行環境で使用可能か調べる．
+bool
+is_supported(const Kernel& kernel)
+{
+  string name(kernel.mName);
+#if defined(__GNUC__) && defined(__x86_64__)
+  if ( name == "avx512" ) {
+    return __builtin_cpu_supports("avx512f") &&
+      __builtin_cpu_supports("avx512vpopcntdq");
+  }
+  if ( name == "avx2" ) {
+    return __builtin_cpu_supports("avx2") &&
+      __builtin_cpu_supports("popcnt");
+  }
+  if ( name == "popcnt" ) {
+    return __builtin_cpu_supports("popcnt");
+  }
+#endif
+  return name == "scalar";
+}
+
+// 使用可能なもののうち最良のカーネルを返す．
+const Kernel*
+best_kernel()
+{
+  for (ymuint i = 0; i < kernel_num; ++ i) {
+    if ( is_supported(kernel_table[i]) ) {
+      return &kernel_table[i];
+    }
+  }
+  return &kernel_table[kernel_num - 1];
+}
+
+// 現在のカーネル
+const Kernel* cur_kernel = best_kernel();
+
+END_NONAMESPACE
+
+// @brief 行ごとの分類を行う．
+// @param[in] body 最初の行のブロックの先頭
+// @param[in] stride 行の間隔(ブロック数)
+// @param[in] nblk 1行あたりのブロック数
+// @param[in] num 行数
+// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+// @param[out] bits 結果を格納するビットベクタ
+void
+rv_classify_rows(const ymuint64* body,
+		 ymuint64 stride,
+		 ymuint nblk,
+		 ymuint64 num,
+		 const ymuint64* mask,
+		 ymuint64* bits)
+{
+  // ブロック数に応じて特殊化版を選ぶ．
+  ymuint k = nblk <= kFixedMax ? nblk : 0;
+  (*cur_kernel->mClassify[k])(body, stride, nblk, num, mask, bits);
+}
+
+// @brief 行ごとに分類して 1 に分類された行数を数える．
+// @param[in] body 最初の行のブロックの先頭
+// @param[in] stride 行の間隔(ブロック数)
+// @param[in] nblk 1行あたりのブロック数
+// @param[in] num 行数
+// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+ymuint64
+rv_count1_rows(const ymuint64* body,
+	       ymuint64 stride,
+	       ymuint nblk,
+	       ymuint64 num,
+	       const ymuint64* mask)
+{
+  ymuint k = nblk <= kFixedMax ? nblk : 0;
+  return (*cur_kernel->mCount1Rows[k])(body, stride, nblk, num, mask);
+}
+
+// @brief 行ごとに分類した結果とビットベクタの XOR を求めて 1 の数を数える．
+// @param[in] body 最初の行のブロックの先頭
+// @param[in] stride 行の間隔(ブロック数)
+// @param[in] nblk 1行あたりのブロック数
+// @param[in] num 行数
+// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+// @param[in] src ビットベクタ
+// @param[out] dst 結果を格納するビットベクタ
+// @return dst 中の 1 の数
+ymuint64
+rv_xor_count_rows(const ymuint64* body,
+		  ymuint64 stride,
+		  ymuint nblk,
+		  ymuint64 num,
+		  const ymuint64* mask,
+		  const ymuint64* src,
+		  ymuint64* dst)
+{
+  ymuint k = nblk <= kFixedMax ? nblk : 0;
+  return (*cur_kernel->mXorCountRows[k])(body, stride, nblk, num, mask, src, dst);
+}
+
+// @brief ビットベクタ中の 1 の数を数える．
+// @param[in] bits ビットベクタ
+// @param[in] n ブロック数
+ymuint64
+rv_count_bits(const ymuint64* bits,
+	      ymuint64 n)
+{
+  return (*cur_kernel->mCount)(bits, n);
+}
+
+// @brief 2つのビットベクタの XOR を求めて 1 の数を数える．
+// @param[in] src1, src2 ビットベクタ
+// @param[out] dst 結果を格納するビットベクタ
+// @param[in] n ブロック数
+// @return dst 中の 1 の数
+ymuint64
+rv_xor_count(const ymuint64* src1,
+	     const ymuint64* src2,
+	     ymuint64* dst,
+	     ymuint64 n)
+{
+  return (*cur_kernel->mXorCount)(src1, src2, dst, n);
+}
+
+// @brief 複数の分類結果の同時分布を求める．
+// @param[in] bits_list 分類結果のビットベクタの配列(t 個)
+// @param[in] t 分類結果の数 ( t <= kRvJointMax )
+// @param[in] num ビットベクタのビット数(行数)
+// @param[out] hist 結果を格納する配列(2^t 個)
+void
+rv_joint_count(const ymuint64* const* bits_list,
+	       ymuint t,
+	       ymuint64 num,
+	       ymuint64* hist)
+{
+  ASSERT_COND( t <= kRvJointMax );
+  (*cur_kernel->mJointCount)(bits_list, t, num, hist);
+}
+
+// @brief 行ごとに分類して複数の変数の同時分布を求める．
+// @param[in] body 最初の行のブロックの先頭
+// @param[in] stride 行の間隔(ブロック数)
+// @param[in] nblk 1行あたりのブロック数
+// @param[in] num 行数
+// @param[in] mask_list 分類用の変数のブロックの配列の配列(t 個)
+// @param[in] t 変数の数 ( t <= kRvJointMax )
+// @param[out] hist 結果を格納する配列(2^t 個)
+void
+rv_joint_count_rows(const ymuint64* body,
+		    ymuint64 stride,
+		    ymuint nblk,
+		    ymuint64 num,
+		    const ymuint64* const* mask_list,
+		    ymuint t,
+		    ymuint64* hist)
+{
+  ASSERT_COND( t <= kRvJointMax );
+  ymuint k = nblk <= kFixedMax ? nblk : 0;
+  (*cur_kernel->mJointCountRows[k])(body, stride, nblk, num, mask_list, t, hist);
+}
+
+// @brief 使用するカーネルを選ぶ．
+// @param[in] name カーネル名
+// @retval true 選択した．
+// @retval false 名前が不正か実行環境で使用できなかった．
+bool
+rv_select_kernel(const string& name)
+{
+  if ( name == string() ) {
+    cur_kernel = best_kernel();
+    return true;
+  }
+  for (ymuint i = 0; i < kernel_num; ++ i) {
+    const Kernel& kernel = kernel_table[i];
+    if ( name == kernel.mName ) {
+      if ( !is_supported(kernel) ) {
+	return false;
+      }
+      cur_kernel = &kernel;
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 現在使用しているカーネル名を返す．
+const char*
+rv_kernel_name()
+{
+  return cur_kernel->mName;
+}
+
+END_NAMESPACE_IGF
@@ -0,0 +1,158 @@
+#ifndef RVKERNEL_H
+#define RVKERNEL_H
+
+/// @file RvKernel.h
+/// @brief 登録ベクタの分類用のカーネル関数のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+///
+/// 以下のカーネルを実行環境の CPU に応じて切り替えて用いる．
+/// - "avx512" : AVX-512F + VPOPCNTDQ 命令を用いる．8行ずつ処理する．
+/// - "avx2"   : AVX2 命令を用いる．4行ずつ処理する．
+/// - "popcnt" : POPCNT 命令を用いたスカラー版
+/// - "scalar" : 特別な命令を用いないスカラー版
+/// 特に指定しなければ使用可能なもののうち最初のものが選ばれる．
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+/// @brief 行ごとの分類を行う．
+/// @param[in] body 最初の行のブロックの先頭
+/// @param[in] stride 行の間隔(ブロック数)
+/// @param[in] nblk 1行あたりのブロック数
+/// @param[in] num 行数
+/// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+/// @param[out] bits 結果を格納するビットベクタ
+///
+/// i 番目の行とマスクの AND のパリティを bits の i ビット目に書き込む．
+/// bits は (num + 63) / 64 ブロックの大きさを持つ必要がある．
+/// 余りのビットは 0 となる．
+/// nblk が 1, 2 の場合はブロックのループを展開した特殊化版を用いる．
+void
+rv_classify_rows(const ymuint64* body,
+		 ymuint64 stride,
+		 ymuint nblk,
+		 ymuint64 num,
+		 const ymuint64* mask,
+		 ymuint64* bits);
+
+/// @brief 行ごとに分類して 1 に分類された行数を数える．
+/// @param[in] body 最初の行のブロックの先頭
+/// @param[in] stride 行の間隔(ブロック数)
+/// @param[in] nblk 1行あたりのブロック数
+/// @param[in] num 行数
+/// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+///
+/// rv_classify_rows() と rv_count_bits() を続けて呼ぶのと同じだが
+/// 分類結果のビットベクタを作らない．
+/// nblk が 1, 2 の場合は特殊化版を用いる．
+ymuint64
+rv_count1_rows(const ymuint64* body,
+	       ymuint64 stride,
+	       ymuint nblk,
+	       ymuint64 num,
+	       const ymuint64* mask);
+
+/// @brief 行ごとに分類した結果とビットベクタの XOR を求めて 1 の数を数える．
+/// @param[in] body 最初の行のブロックの先頭
+/// @param[in] stride 行の間隔(ブロック数)
+/// @param[in] nblk 1行あたりのブロック数
+/// @param[in] num 行数
+/// @param[in] mask 分類用の変数のブロックの配列(nblk 個)
+/// @param[in] src ビットベクタ
+/// @param[out] dst 結果を格納するビットベクタ
+/// @return dst 中の 1 の数
+///
+/// 分類結果を src と合成する(合成変数の分類結果を求める)のに用いる．
+/// src と dst は (num + 63) / 64 ブロックの大きさを持ち，
+/// src の余りのビットは 0 でなければならない．dst は src と同じでもよい．
+/// nblk が 1, 2 の場合は特殊化版を用いる．
+ymuint64
+rv_xor_count_rows(const ymuint64* body,
+		  ymuint64 stride,
+		  ymuint nblk,
+		  ymuint64 num,
+		  const ymuint64* mask,
+		  const ymuint64* src,
+		  ymuint64* dst);
+
+/// @brief ビットベクタ中の 1 の数を数える．
+/// @param[in] bits ビットベクタ
+/// @param[in] n ブロック数
+ymuint64
+rv_count_bits(const ymuint64* bits,
+	      ymuint64 n);
+
+/// @brief 2つのビットベクタの XOR を求めて 1 の数を数える．
+/// @param[in] src1, src2 ビットベクタ
+/// @param[out] dst 結果を格納するビットベクタ
+/// @param[in] n ブロック数
+/// @return dst 中の 1 の数
+///
+/// dst は src1 か src2 と同じでもよい．
+ymuint64
+rv_xor_count(const ymuint64* src1,
+	     const ymuint64* src2,
+	     ymuint64* dst,
+	     ymuint64 n);
+
+/// @brief rv_joint_count() で扱える分類結果の最大数
+const ymuint kRvJointMax = 10;
+
+/// @brief 複数の分類結果の同時分布を求める．
+/// @param[in] bits_list 分類結果のビットベクタの配列(t 個)
+/// @param[in] t 分類結果の数 ( t <= kRvJointMax )
+/// @param[in] num ビットベクタのビット数(行数)
+/// @param[out] hist 結果を格納する配列(2^t 個)
+///
+/// hist[p] には i 番目の分類結果が p の i ビット目と等しい行の数が入る．
+/// 各ビットベクタは (num + 63) / 64 ブロックの大きさを持つ必要がある．
+void
+rv_joint_count(const ymuint64* const* bits_list,
+	       ymuint t,
+	       ymuint64 num,
+	       ymuint64* hist);
+
+/// @brief 行ごとに分類して複数の変数の同時分布を求める．
+/// @param[in] body 最初の行のブロックの先頭
+/// @param[in] stride 行の間隔(ブロック数)
+/// @param[in] nblk 1行あたりのブロック数
+/// @param[in] num 行数
+/// @param[in] mask_list 分類用の変数のブロックの配列の配列(t 個)
+/// @param[in] t 変数の数 ( t <= kRvJointMax )
+/// @param[out] hist 結果を格納する配列(2^t 個)
+///
+/// 各変数で rv_classify_rows() を呼んでから rv_joint_count() を呼ぶのと同じだが
+/// 64行ずつ分類して数えるので分類結果のビットベクタを作らない．
+/// nblk が 1, 2 の場合は特殊化版を用いる．
+void
+rv_joint_count_rows(const ymuint64* body,
+		    ymuint64 stride,
+		    ymuint nblk,
+		    ymuint64 num,
+		    const ymuint64* const* mask_list,
+		    ymuint t,
+		    ymuint64* hist);
+
+/// @brief 使用するカーネルを選ぶ．
+/// @param[in] name カーネル名
+/// @retval true 選択した．
+/// @retval false 名前が不正か実行環境で使用できなかった．
+///
+/// 空文字列の場合には使用可能なもののうち最良のものを選ぶ．
+/// 主にテストと性能比較に用いる．
+bool
+rv_select_kernel(const string& name);
+
+/// @brief 現在使用しているカーネル名を返す．
+const char*
+rv_kernel_name();
+
+END_NAMESPACE_IGF
+
+#endif // RVKERNEL_H
@@ -0,0 +1,512 @@
+
+/// @file RvMatrix.cc
+/// @brief RvMatrix の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RvMatrix.h"
+#include "RegVect.h"
+#include "Variable.h"
+#include "SparseVariable.h"
+#include "RvKernel.h"
+#include <cstdlib>
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 列方向の処理を一度に行うブロック数
+const ymuint kChunkSize = 64;
+
+// 64 バイト境界に整列した領域を確保する．
+ymuint64*
+alloc_blocks(ymuint64 n)
+{
+  if ( n == 0 ) {
+    return nullptr;
+  }
+  void* p = nullptr;
+  if ( posix_memalign(&p, 64, n * sizeof(ymuint64)) != 0 ) {
+    cerr << "RvMatrix: out of memory" << endl;
+    abort();
+  }
+  return static_cast<ymuint64*>(p);
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス RvMatrix
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+RvMatrix::RvMatrix() :
+  mVectSize(0),
+  mBlockSize(0),
+  mVectNum(0),
+  mBody(nullptr),
+  mColumnSize(0),
+  mColBody(nullptr)
+{
+}
+
+// @brief ベクタのリストを指定したコンストラクタ
+// @param[in] rv_list ベクタのリスト
+RvMatrix::RvMatrix(const vector<const RegVect*>& rv_list) :
+  mVectSize(0),
+  mBlockSize(0),
+  mVectNum(0),
+  mBody(nullptr),
+  mColumnSize(0),
+  mColBody(nullptr)
+{
+  set(rv_list);
+}
+
+// @brief デストラクタ
+RvMatrix::~RvMatrix()
+{
+  clear();
+}
+
+// @brief 内容を設定する．
+// @param[in] rv_list ベクタのリスト
+//
+// 以前の内容は破棄される．
+void
+RvMatrix::set(const vector<const RegVect*>& rv_list)
+{
+  clear();
+
+  if ( rv_list.empty() ) {
+    return;
+  }
+
+  mVectSize = rv_list[0]->size();
+  mBlockSize = (mVectSize + 63) / 64;
+  mVectNum = rv_list.size();
+
+  mColumnSize = (mVectNum + 63) / 64;
+  mBody = alloc_blocks(static_cast<ymuint64>(mVectNum) * mBlockSize);
+  ymuint64 col_size = static_cast<ymuint64>(mVectSize) * mColumnSize;
+  mColBody = alloc_blocks(col_size);
+  for (ymuint64 i = 0; i < col_size; ++ i) {
+    mColBody[i] = 0ULL;
+  }
+
+  mIndexArray.resize(mVectNum);
+  ymuint64* dst = mBody;
+  for (ymuint i = 0; i < mVectNum; ++ i, dst += mBlockSize) {
+    const RegVect* rv = rv_list[i];
+    ASSERT_COND( rv->size() == mVectSize );
+    for (ymuint j = 0; j < mBlockSize; ++ j) {
+      dst[j] = rv->mBody[j];
+    }
+    mIndexArray[i] = rv->index();
+
+    // 1 のビットを列に転置する．
+    ymuint64 bit = 1ULL << (i % 64);
+    ymuint64* col = mColBody + (i / 64);
+    for (ymuint j = 0; j < mBlockSize; ++ j) {
+      for (ymuint64 tmp = dst[j]; tmp != 0ULL; tmp &= (tmp - 1)) {
+	ymuint b = j * 64 + __builtin_ctzll(tmp);
+	col[static_cast<ymuint64>(b) * mColumnSize] |= bit;
+      }
+    }
+  }
+}
+
+// @brief 内容を空にする．
+void
+RvMatrix::clear()
+{
+  free(mBody);
+  free(mColBody);
+  mBody = nullptr;
+  mColBody = nullptr;
+  mVectSize = 0;
+  mBlockSize = 0;
+  mVectNum = 0;
+  mColumnSize = 0;
+  mIndexArray.clear();
+}
+
+// @brief 行を分類する．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+// @param[in] var 分類用の変数
+//
+// RegVect::classify() と同じく 0 か 1 を返す．
+ymuint
+RvMatrix::classify(ymuint pos,
+		   const Variable& var) const
+{
+  const ymuint64* body = row(pos);
+  ymuint64 tmp = 0ULL;
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    tmp ^= var.raw_data(i) & body[i];
+  }
+  return parity(tmp);
+}
+
+// @brief ブロック列で行を分類する．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+// @param[in] mask 分類用の変数のブロック列(block_size() 個)
+ymuint
+RvMatrix::classify(ymuint pos,
+		   const ymuint64* mask) const
+{
+  const ymuint64* body = row(pos);
+  ymuint64 tmp = 0ULL;
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    tmp ^= mask[i] & body[i];
+  }
+  return parity(tmp);
+}
+
+// @brief 疎な表現の変数で行を分類する．
+// @param[in] pos 行番号 ( 0 <= pos < vect_num() )
+// @param[in] var 分類用の変数
+ymuint
+RvMatrix::classify(ymuint pos,
+		   const SparseVariable& var) const
+{
+  ymuint ans = 0;
+  for (ymuint i = 0; i < var.degree(); ++ i) {
+    ans ^= val(pos, var.vid(i));
+  }
+  return ans;
+}
+
+// @brief 連続した行をまとめて分類する．
+// @param[in] var 分類用の変数
+// @param[in] pos 先頭の行番号
+// @param[in] num 行数 ( pos + num <= vect_num() )
+// @param[out] bits 分類結果を格納する領域
+void
+RvMatrix::classify_rows(const Variable& var,
+			ymuint pos,
+			ymuint num,
+			ymuint64* bits) const
+{
+  ASSERT_COND( var.var_size() == mVectSize );
+  ASSERT_COND( pos + num <= mVectNum );
+
+  if ( num == 0 ) {
+    return;
+  }
+  vector<ymuint64> mask(mBlockSize);
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mask[i] = var.raw_data(i);
+  }
+  rv_classify_rows(row(pos), mBlockSize, mBlockSize, num, &mask[0], bits);
+}
+
+// @brief 連続した行をブロック列でまとめて分類する．
+// @param[in] mask 分類用の変数のブロック列(block_size() 個)
+// @param[in] pos 先頭の行番号
+// @param[in] num 行数 ( pos + num <= vect_num() )
+// @param[out] bits 分類結果を格納する領域
+void
+RvMatrix::classify_rows(const ymuint64* mask,
+			ymuint pos,
+			ymuint num,
+			ymuint64* bits) const
+{
+  ASSERT_COND( pos + num <= mVectNum );
+
+  if ( num == 0 ) {
+    return;
+  }
+  rv_classify_rows(row(pos), mBlockSize, mBlockSize, num, mask, bits);
+}
+
+// @brief すべての行を分類する．
+// @param[in] var 分類用の変数
+// @return 分類結果を表す vect_num() ビットのビットベクタ
+vector<ymuint64>
+RvMatrix::classify_all(const Variable& var) const
+{
+  vector<ymuint64> bits(mColumnSize);
+  if ( mColumnSize > 0 ) {
+    classify_all(var, &bits[0]);
+  }
+  return bits;
+}
+
+// @brief すべての行を分類する．
+// @param[in] var 分類用の変数
+// @param[out] bits 分類結果を格納する領域
+void
+RvMatrix::classify_all(const Variable& var,
+		       ymuint64* bits) const
+{
+  ASSERT_COND( var.var_size() == mVectSize );
+
+  for (ymuint w0 = 0; w0 < mColumnSize; w0 += kChunkSize) {
+    ymuint w1 = w0 + kChunkSize;
+    if ( w1 > mColumnSize ) {
+      w1 = mColumnSize;
+    }
+    classify_range(var, w0, w1, bits + w0);
+  }
+}
+
+// @brief 疎な表現の変数ですべての行を分類する．
+// @param[in] var 分類用の変数
+// @param[out] bits 分類結果を格納する領域
+void
+RvMatrix::classify_all(const SparseVariable& var,
+		       ymuint64* bits) const
+{
+  ASSERT_COND( var.var_size() == mVectSize );
+
+  for (ymuint w = 0; w < mColumnSize; ++ w) {
+    bits[w] = 0ULL;
+  }
+  for (ymuint i = 0; i < var.degree(); ++ i) {
+    const ymuint64* col = column(var.vid(i));
+    for (ymuint w = 0; w < mColumnSize; ++ w) {
+      bits[w] ^= col[w];
+    }
+  }
+}
+
+// @brief 変数で 1 に分類される行数を数える．
+// @param[in] var 分類用の変数
+//
+// 分類結果を kChunkSize ブロックずつ求めて 1 の数を数える．
+ymuint64
+RvMatrix::count1(const Variable& var) const
+{
+  ASSERT_COND( var.var_size() == mVectSize );
+
+  if ( !SparseVariable::is_preferred_column(var) ) {
+    // 列の XOR より行ごとの分類のほうが速い．
+    vector<ymuint64> mask(mBlockSize);
+    for (ymuint i = 0; i < mBlockSize; ++ i) {
+      mask[i] = var.raw_data(i);
+    }
+    return rv_count1_rows(mBody, mBlockSize, mBlockSize, mVectNum, &mask[0]);
+  }
+
+  ymuint64 n1 = 0;
+  ymuint64 acc[kChunkSize];
+  for (ymuint w0 = 0; w0 < mColumnSize; w0 += kChunkSize) {
+    ymuint w1 = w0 + kChunkSize;
+    if ( w1 > mColumnSize ) {
+      w1 = mColumnSize;
+    }
+    classify_range(var, w0, w1, acc);
+    n1 += count_bits(acc, w1 - w0);
+  }
+  return n1;
+}
+
+// @brief 分類結果に変数の分類結果を合成して 1 の数を数える．
+// @param[in] var 分類用の変数
+// @param[in] src 分類結果のビットベクタ(column_size() ブロック)
+// @param[out] dst 結果を格納するビットベクタ(column_size() ブロック)
+// @return dst 中の 1 の数
+ymuint64
+RvMatrix::xor_classify(const Variable& var,
+		       const ymuint64* src,
+		       ymuint64* dst) const
+{
+  ASSERT_COND( var.var_size() == mVectSize );
+
+  if ( mColumnSize == 0 ) {
+    return 0;
+  }
+  if ( !SparseVariable::is_preferred_column(var) ) {
+    vector<ymuint64> mask(mBlockSize);
+    for (ymuint i = 0; i < mBlockSize; ++ i) {
+      mask[i] = var.raw_data(i);
+    }
+    return rv_xor_count_rows(mBody, mBlockSize, mBlockSize, mVectNum, &mask[0], src, dst);
+  }
+
+  vector<ymuint64> bits(mColumnSize);
+  classify_all(var, &bits[0]);
+  return xor_bits(src, &bits[0], dst, mColumnSize);
+}
+
+// @brief 複数の変数で 1 に分類される行数をまとめて数える．
+// @param[in] var_list 分類用の変数のリスト
+// @param[out] n1_list 結果を格納するリスト
+//
+// 結果の行列(変数 x 行)を kChunkSize ブロックの列の範囲ごとに求める．
+// 範囲内の列は最初の変数の処理でキャッシュに載るので
+// 残りの変数はキャッシュ上の列のみを参照する．
+void
+RvMatrix::count1(const vector<Variable>& var_list,
+		 vector<ymuint64>& n1_list) const
+{
+  ymuint nv = var_list.size();
+  n1_list.clear();
+  n1_list.resize(nv, 0);
+
+  // 各変数に含まれる列の番号をあらかじめ求めておく．
+  // i 番目の変数の列は col_list[col_begin[i]] から
+  // col_list[col_begin[i + 1] - 1] まで
+  vector<ymuint> col_begin(nv + 1);
+  vector<ymuint> col_list;
+  for (ymuint i = 0; i < nv; ++ i) {
+    const Variable& var = var_list[i];
+    ASSERT_COND( var.var_size() == mVectSize );
+    col_begin[i] = col_list.size();
+    for (ymuint j = 0; j < mBlockSize; ++ j) {
+      for (ymuint64 tmp = var.raw_data(j); tmp != 0ULL; tmp &= (tmp - 1)) {
+	col_list.push_back(j * 64 + __builtin_ctzll(tmp));
+      }
+    }
+  }
+  col_begin[nv] = col_list.size();
+
+  ymuint64 acc[kChunkSize];
+  for (ymuint w0 = 0; w0 < mColumnSize; w0 += kChunkSize) {
+    ymuint w1 = w0 + kChunkSize;
+    if ( w1 > mColumnSize ) {
+      w1 = mColumnSize;
+    }
+    ymuint nw = w1 - w0;
+    for (ymuint i = 0; i < nv; ++ i) {
+      for (ymuint w = 0; w < nw; ++ w) {
+	acc[w] = 0ULL;
+      }
+      for (ymuint c = col_begin[i]; c < col_begin[i + 1]; ++ c) {
+	const ymuint64* col = column(col_list[c]) + w0;
+	for (ymuint w = 0; w < nw; ++ w) {
+	  acc[w] ^= col[w];
+	}
+      }
+      n1_list[i] += count_bits(acc, nw);
+    }
+  }
+}
+
+// @brief 複数の変数による分類結果の同時分布を求める．
+// @param[in] bits_list 分類結果のビットベクタのリスト
+// @param[out] hist 結果を格納するリスト
+void
+RvMatrix::joint_count(const vector<const ymuint64*>& bits_list,
+		      vector<ymuint64>& hist) const
+{
+  ymuint t = bits_list.size();
+  ASSERT_COND( t <= kJointMax );
+  hist.resize(1U << t);
+  rv_joint_count(t > 0 ? &bits_list[0] : nullptr, t, mVectNum, &hist[0]);
+}
+
+// @brief 複数の変数による分類の同時分布を求める．
+// @param[in] var_list 分類用の変数のリスト
+// @param[out] hist 結果を格納するリスト
+void
+RvMatrix::joint_count(const vector<Variable>& var_list,
+		      vector<ymuint64>& hist) const
+{
+  ymuint t = var_list.size();
+  bool dense = t > 0 && t <= kJointMax;
+  for (ymuint i = 0; i < t && dense; ++ i) {
+    if ( SparseVariable::is_preferred_column(var_list[i]) ) {
+      dense = false;
+    }
+  }
+  if ( dense ) {
+    // すべて行ごとの分類のほうが速いので分類結果を作らずに数える．
+    vector<ymuint64> mask_body(static_cast<ymuint64>(mBlockSize) * t);
+    vector<const ymuint64*> mask_list(t);
+    for (ymuint i = 0; i < t; ++ i) {
+      ymuint64* mask = &mask_body[0] + static_cast<ymuint64>(i) * mBlockSize;
+      for (ymuint j = 0; j < mBlockSize; ++ j) {
+	mask[j] = var_list[i].raw_data(j);
+      }
+      mask_list[i] = mask;
+    }
+    hist.resize(1U << t);
+    rv_joint_count_rows(mBody, mBlockSize, mBlockSize, mVectNum, &mask_list[0], t, &hist[0]);
+    return;
+  }
+
+  vector<ymuint64> bits_body(static_cast<ymuint64>(mColumnSize) * t);
+  vector<const ymuint64*> bits_list(t);
+  for (ymuint i = 0; i < t; ++ i) {
+    ymuint64* bits = &bits_body[0] + static_cast<ymuint64>(i) * mColumnSize;
+    if ( mColumnSize > 0 ) {
+      classify_all(var_list[i], bits);
+    }
+    bits_list[i] = bits;
+  }
+  joint_count(bits_list, hist);
+}
+
+// @brief ビットベクタ中の 1 の数を数える．
+// @param[in] bits ビットベクタ
+// @param[in] n ブロック数
+ymuint64
+RvMatrix::count_bits(const ymuint64* bits,
+		     ymuint n)
+{
+  return rv_count_bits(bits, n);
+}
+
+// @brief 2つのビットベクタの XOR を求めて 1 の数を数える．
+// @param[in] src1, src2 ビットベクタ
+// @param[out] dst 結果を格納するビットベクタ
+// @param[in] n ブロック数
+// @return dst 中の 1 の数
+ymuint64
+RvMatrix::xor_bits(const ymuint64* src1,
+		   const ymuint64* src2,
+		   ymuint64* dst,
+		   ymuint n)
+{
+  return rv_xor_count(src1, src2, dst, n);
+}
+
+// @brief 行の分類と数え上げに用いるカーネルを選ぶ．
+// @param[in] name カーネル名 ("avx512", "avx2", "popcnt", "scalar")
+// @retval true 選択した．
+// @retval false 名前が不正か実行環境で使用できなかった．
+bool
+RvMatrix::select_kernel(const string& name)
+{
+  return rv_select_kernel(name);
+}
+
+// @brief 現在のカーネル名を返す．
+const char*
+RvMatrix::kernel_name()
+{
+  return rv_kernel_name();
+}
+
+// @brief 列の範囲 [w0, w1) のブロックについて分類を行う．
+// @param[in] var 分類用の変数
+// @param[in] w0, w1 ブロックの範囲
+// @param[out] acc 結果を格納する領域(w1 - w0 ブロック)
+void
+RvMatrix::classify_range(const Variable& var,
+			 ymuint w0,
+			 ymuint w1,
+			 ymuint64* acc) const
+{
+  ymuint nw = w1 - w0;
+  for (ymuint w = 0; w < nw; ++ w) {
+    acc[w] = 0ULL;
+  }
+  for (ymuint j = 0; j < mBlockSize; ++ j) {
+    for (ymuint64 tmp = var.raw_data(j); tmp != 0ULL; tmp &= (tmp - 1)) {
+      ymuint b = j * 64 + __builtin_ctzll(tmp);
+      const ymuint64* col = column(b) + w0;
+      for (ymuint w = 0; w < nw; ++ w) {
+	acc[w] ^= col[w];
+      }
+    }
+  }
+}
+
+END_NAMESPACE_IGF
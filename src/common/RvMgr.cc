@@ -10,30 +10,20 @@
 #include "RvMgr.h"
 #include "RegVect.h"
 #include "Variable.h"
+#include "SparseVariable.h"
 #include "SigFunc.h"
 //#include "FuncVect.h"
-#include "ym/HashFunc.h"
-#include "ym/HashSet.h"
+#include "RvHash.h"
+#include "RvMatrix.h"
+#include "RvIo.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <algorithm>
+#include <thread>
 
 
-BEGIN_NAMESPACE_YM
-
-//////////////////////////////////////////////////////////////////////
-// HashFunc<RegVect*> の特殊化
-//////////////////////////////////////////////////////////////////////
-template<>
-struct
-HashFunc<nsIgf::RegVect*>
-{
-  ymuint
-  operator()(nsIgf::RegVect* key) const
-  {
-    return key->hash();
-  }
-};
-
-END_NAMESPACE_YM
-
 BEGIN_NAMESPACE_IGF
 
 //////////////////////////////////////////////////////////////////////
@@ -47,6 +37,12 @@ RvMgr::RvMgr()
   mBlockSize = 0;
   mRvSize = 0;
   mAlloc = NULL;
+  mMapAddr = nullptr;
+  mMapSize = 0;
+  mProbeNum = 0;
+  mProbeTotal = 0;
+  mProbeMax = 0;
+  mMatrixValid = false;
 }
 
 // @brief デストラクタ
@@ -54,30 +50,11 @@ RvMgr::RvMgr()
 RvMgr::~RvMgr()
 {
   delete mAlloc;
-}
-
-
-BEGIN_NONAMESPACE
-
-ymuint
-read_num(const string& str,
-	 ymuint& rpos)
-{
-  ymuint ans = 0;
-  for ( ; ; ) {
-    char c = str[rpos];
-    ++ rpos;
-    if ( c >= '0' && c <= '9' ) {
-      ans = ans * 10 + static_cast<ymuint>(c - '0');
-    }
-    if ( c == ' ' || c == '\0' ) {
-      return ans;
-    }
+  if ( mMapAddr != nullptr ) {
+    munmap(mMapAddr, mMapSize);
   }
 }
 
-END_NONAMESPACE
-
 // @brief データを読み込む．
 // @param[in] s 読み込み元のストリーム演算子
 // @retval true 読み込みが成功した．
@@ -89,57 +66,568 @@ RvMgr::read_data(istream& s)
   string buf;
   getline(s, buf);
 
-  ymuint rpos = 0;
-  ymuint n = read_num(buf, rpos);
-  ymuint k = read_num(buf, rpos);
+  const char* p = buf.c_str();
+  const char* end = p + buf.size();
+  ymuint n = rv_read_num(p, end);
+  ymuint k = rv_read_num(p, end);
 
   set_size(n);
 
   mVectList.clear();
+  mMatrixValid = false;
   mVectList.reserve(k);
 
-  HashSet<RegVect*> vect_hash;
+  RvHash vect_hash(mBlockSize, k);
   for (ymuint i = 0; i < k; ++ i) {
-    string buf;
     if ( !getline(s, buf) ) {
       cerr << "read error" << endl;
       return false;
     }
-    if ( buf.size() != n ) {
-      cerr << "data length error at line " << (i + 1) << endl;
+    if ( !read_line(buf.c_str(), buf.size(), i + 1, vect_hash) ) {
       return false;
     }
-    for (ymuint j = 0; j < n; ++ j) {
-      char c = buf[j];
-      if ( c != '0' && c != '1' ) {
-	cerr << "illegal charactor at line "
-	     << (i + 1) << ", column " << (j + 1) << endl;
-	return false;
+  }
+  set_hash_stats(vect_hash);
+
+  return true;
+}
+
+// @brief ファイルからデータを読み込む．
+// @param[in] filename ファイル名
+// @param[in] thread_num 解析に用いるスレッド数
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+//
+// ファイルをメモリにマップして直接解析する．
+// データの形式，重複の扱い，エラーメッセージは
+// read_data(istream& s) と同じ．
+bool
+RvMgr::read_data(const string& filename,
+		 ymuint thread_num)
+{
+  if ( thread_num == 0 ) {
+    thread_num = std::thread::hardware_concurrency();
+    if ( thread_num == 0 ) {
+      thread_num = 1;
+    }
+  }
+
+  int fd = open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    cerr << "Could not open " << filename << endl;
+    return false;
+  }
+
+  struct stat st;
+  if ( fstat(fd, &st) < 0 || st.st_size == 0 ) {
+    close(fd);
+    cerr << "read error" << endl;
+    return false;
+  }
+
+  ymuint64 size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( addr == MAP_FAILED ) {
+    cerr << "Could not map " << filename << endl;
+    return false;
+  }
+  madvise(addr, size, MADV_SEQUENTIAL);
+
+  const char* begin = static_cast<const char*>(addr);
+  bool stat = (thread_num > 1) ?
+    read_body_mt(begin, begin + size, thread_num) :
+    read_body(begin, begin + size);
+
+  munmap(addr, size);
+
+  return stat;
+}
+
+// @brief 内容をバイナリ形式(.rvb)で書き出す．
+// @param[in] filename ファイル名
+// @retval true 書き出しが成功した．
+// @retval false 書き出しが失敗した．
+bool
+RvMgr::write_binary(const string& filename) const
+{
+  ofstream ofs(filename.c_str(), ios::out | ios::binary);
+  if ( !ofs ) {
+    cerr << "Could not create " << filename << endl;
+    return false;
+  }
+
+  RvbHeader header;
+  memcpy(header.mMagic, rvb_magic, sizeof(rvb_magic));
+  header.mVectSize = mVectSize;
+  header.mBlockSize = mBlockSize;
+  header.mRecSize = mRvSize;
+  header.mNum = mVectList.size();
+  header.mReserved = 0;
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  // RegVect のメモリイメージをそのまま書き出す．
+  for (vector<const RegVect*>::const_iterator p = mVectList.begin();
+       p != mVectList.end(); ++ p) {
+    const RegVect* rv = *p;
+    ofs.write(reinterpret_cast<const char*>(rv), mRvSize);
+  }
+
+  if ( !ofs ) {
+    cerr << "write error" << endl;
+    return false;
+  }
+  return true;
+}
+
+// @brief バイナリ形式(.rvb)のファイルをマップする．
+// @param[in] filename ファイル名
+// @retval true マップが成功した．
+// @retval false マップが失敗した．
+bool
+RvMgr::map_binary(const string& filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    cerr << "Could not open " << filename << endl;
+    return false;
+  }
+
+  struct stat st;
+  if ( fstat(fd, &st) < 0 ||
+       static_cast<ymuint64>(st.st_size) < sizeof(RvbHeader) ) {
+    close(fd);
+    cerr << "read error" << endl;
+    return false;
+  }
+
+  ymuint64 size = st.st_size;
+  void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( addr == MAP_FAILED ) {
+    cerr << "Could not map " << filename << endl;
+    return false;
+  }
+
+  const RvbHeader* header = static_cast<const RvbHeader*>(addr);
+  if ( memcmp(header->mMagic, rvb_magic, sizeof(rvb_magic)) != 0 ) {
+    cerr << filename << ": not a rvb file" << endl;
+    munmap(addr, size);
+    return false;
+  }
+
+  // ヘッダと各レコードの内容をすべて確かめてから設定を行う．
+  // 失敗した時はこのオブジェクトの状態を変えない．
+  // k * rv_size が溢れないように割り算で比べる．
+  ymuint vect_size = header->mVectSize;
+  ymuint nblk = (vect_size + 63) / 64;
+  ymuint64 rv_size = sizeof(RegVect) + 8 * (nblk - 1);
+  ymuint64 k = header->mNum;
+  bool ok = vect_size > 0 &&
+    header->mBlockSize == nblk && header->mRecSize == rv_size &&
+    k <= (size - sizeof(RvbHeader)) / rv_size;
+  const char* rec0 = static_cast<const char*>(addr) + sizeof(RvbHeader);
+  if ( ok ) {
+    const char* rec = rec0;
+    for (ymuint64 i = 0; i < k; ++ i, rec += rv_size) {
+      const RegVect* rv = reinterpret_cast<const RegVect*>(rec);
+      if ( rv->size() != vect_size || rv->index() >= k ) {
+	ok = false;
+	break;
       }
     }
-    ymuint id = mVectList.size();
-    RegVect* rv = new_vector(id);
-    for (ymuint j = 0; j < n; ++ j) {
-      ymuint blk = j / 64;
-      ymuint sft = j % 64;
-      char c = buf[j];
-      if ( c == '1' ) {
-	rv->mBody[blk] |= (1ULL << sft);
+  }
+  if ( !ok ) {
+    cerr << filename << ": broken rvb file" << endl;
+    munmap(addr, size);
+    return false;
+  }
+
+  set_size(vect_size);
+  mMapAddr = addr;
+  mMapSize = size;
+
+  // レコードを直接 RegVect として参照する．
+  const char* rec = rec0;
+  mVectList.clear();
+  mMatrixValid = false;
+  mVectList.reserve(k);
+  for (ymuint64 i = 0; i < k; ++ i, rec += mRvSize) {
+    mVectList.push_back(reinterpret_cast<const RegVect*>(rec));
+  }
+
+  return true;
+}
+
+// @brief 読み込み処理の本体
+// @param[in] begin, end データの先頭と末尾
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+bool
+RvMgr::read_body(const char* begin,
+		 const char* end)
+{
+  // 最初の行はベクタのサイズと要素数(残りの行数)
+  const char* p = begin;
+  ymuint n = rv_read_num(p, end);
+  ymuint k = rv_read_num(p, end);
+  const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+  p = (nl != nullptr) ? nl + 1 : end;
+
+  set_size(n);
+
+  mVectList.clear();
+  mMatrixValid = false;
+  mVectList.reserve(k);
+
+  RvHash vect_hash(mBlockSize, k);
+  for (ymuint i = 0; i < k; ++ i) {
+    if ( p == end ) {
+      cerr << "read error" << endl;
+      return false;
+    }
+    const char* nl = static_cast<const char*>(memchr(p, '\n', end - p));
+    const char* eol = (nl != nullptr) ? nl : end;
+    if ( !read_line(p, eol - p, i + 1, vect_hash) ) {
+      return false;
+    }
+    p = (nl != nullptr) ? nl + 1 : end;
+  }
+  set_hash_stats(vect_hash);
+
+  return true;
+}
+
+BEGIN_NONAMESPACE
+
+// thread_num 個のスレッドで func(tid) を実行する．
+template<typename Func>
+void
+run_parallel(ymuint thread_num,
+	     Func func)
+{
+  vector<std::thread> thread_list;
+  thread_list.reserve(thread_num);
+  for (ymuint tid = 0; tid < thread_num; ++ tid) {
+    thread_list.push_back(std::thread(func, tid));
+  }
+  for (ymuint tid = 0; tid < thread_num; ++ tid) {
+    thread_list[tid].join();
+  }
+}
+
+// 行の先頭位置を求める．
+// pos 以降で最初の行頭を返す．
+const char*
+line_head(const char* begin,
+	  const char* pos,
+	  const char* end)
+{
+  if ( pos == begin || pos[-1] == '\n' ) {
+    return pos;
+  }
+  const char* nl = static_cast<const char*>(memchr(pos, '\n', end - pos));
+  return (nl != nullptr) ? nl + 1 : end;
+}
+
+// 並列読み込みで用いる分割単位
+struct Chunk
+{
+  // 先頭
+  const char* mBegin;
+
+  // 末尾
+  const char* mEnd;
+
+  // 最初の行の(全体での)行番号
+  ymuint64 mLineBase;
+
+  // 行数
+  ymuint64 mLineNum;
+
+  // 最初にエラーとなった行番号(1から始まる)
+  // エラーがなければ 0
+  ymuint64 mErrLine;
+
+  // 不正な文字の位置
+  // 行の長さのエラーの時は mVectSize
+  ymuint mErrPos;
+
+  // シャードごとの行番号のリスト
+  vector<vector<ymuint64> > mShardList;
+
+  // この範囲の行のブロックを置く領域(スレッドごとのアリーナ)
+  // mLineBase + i 行目のブロックは mBody[i * ブロック数] から始まる．
+  vector<ymuint64> mBody;
+
+  // この範囲の行のハッシュ値
+  vector<ymuint64> mHash;
+};
+
+END_NONAMESPACE
+
+// @brief 読み込み処理の本体(並列版)
+// @param[in] begin, end データの先頭と末尾
+// @param[in] thread_num スレッド数
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+//
+// 以下の手順で処理を行う．
+// 1. 入力を thread_num 個の行範囲に分割し，各々の行数を数える．
+// 2. 各スレッドが自分の範囲を解析して自分のアリーナにブロックを書き込む．
+//    同時にハッシュ値でシャードに振り分ける．
+// 3. シャードごとに行番号の順にハッシュ表に登録し，
+//    同じ内容のうち最初に現れた行以外を重複とする．
+// 4. 重複でない行に出現順にインデックスを割り当て，
+//    アリーナを範囲の順にたどってブロックを RegVect にコピーする．
+bool
+RvMgr::read_body_mt(const char* begin,
+		    const char* end,
+		    ymuint thread_num)
+{
+  // 最初の行はベクタのサイズと要素数(残りの行数)
+  const char* p = begin;
+  ymuint n = rv_read_num(p, end);
+  ymuint k = rv_read_num(p, end);
+  p = line_head(begin, p, end);
+
+  set_size(n);
+
+  mVectList.clear();
+  mMatrixValid = false;
+  mVectList.reserve(k);
+
+  // 入力を行の範囲に分割する．
+  ymuint nt = thread_num;
+  ymuint ns = thread_num;
+  vector<Chunk> chunk_list(nt);
+  ymuint64 body_size = end - p;
+  for (ymuint t = 0; t < nt; ++ t) {
+    Chunk& chunk = chunk_list[t];
+    chunk.mBegin = line_head(begin, p + body_size * t / nt, end);
+    chunk.mEnd = line_head(begin, p + body_size * (t + 1) / nt, end);
+    chunk.mErrLine = 0;
+    chunk.mErrPos = 0;
+    chunk.mShardList.resize(ns);
+  }
+
+  // 各範囲の行数を数える．
+  run_parallel(nt, [&](ymuint t) {
+      Chunk& chunk = chunk_list[t];
+      ymuint64 c = 0;
+      for (const char* q = chunk.mBegin; q != chunk.mEnd; ++ c) {
+	const char* nl = static_cast<const char*>(memchr(q, '\n', chunk.mEnd - q));
+	q = (nl != nullptr) ? nl + 1 : chunk.mEnd;
+      }
+      chunk.mLineNum = c;
+    });
+
+  ymuint64 nl = 0;
+  for (ymuint t = 0; t < nt; ++ t) {
+    Chunk& chunk = chunk_list[t];
+    chunk.mLineBase = nl;
+    nl += chunk.mLineNum;
+  }
+  // 実際に読み込む行数
+  ymuint64 nr = (nl < k) ? nl : k;
+
+  // 各範囲を解析する．
+  // アリーナは解析するスレッド自身が確保する．
+  ymuint nblk = mBlockSize;
+  run_parallel(nt, [&](ymuint t) {
+      Chunk& chunk = chunk_list[t];
+      ymuint64 base = chunk.mLineBase;
+      ymuint64 cnt = 0;
+      if ( base < nr ) {
+	cnt = nr - base;
+	if ( cnt > chunk.mLineNum ) {
+	  cnt = chunk.mLineNum;
+	}
+      }
+      chunk.mBody.assign(cnt * nblk, 0ULL);
+      chunk.mHash.resize(cnt);
+      ymuint64 line = base;
+      for (const char* q = chunk.mBegin; q != chunk.mEnd && line < nr; ++ line) {
+	const char* nl = static_cast<const char*>(memchr(q, '\n', chunk.mEnd - q));
+	const char* eol = (nl != nullptr) ? nl : chunk.mEnd;
+	ymuint64* body = &chunk.mBody[(line - base) * nblk];
+	ymuint64 len = eol - q;
+	if ( len != mVectSize ) {
+	  chunk.mErrLine = line + 1;
+	  chunk.mErrPos = mVectSize;
+	  return;
+	}
+	ymuint pos = rv_pack_bits(q, mVectSize, body);
+	if ( pos < mVectSize ) {
+	  chunk.mErrLine = line + 1;
+	  chunk.mErrPos = pos;
+	  return;
+	}
+	ymuint64 h = RvHash::hash(body, nblk);
+	chunk.mHash[line - base] = h;
+	// RvHash は下位ビットで位置を決めるので，シャードは上位ビットで決める．
+	chunk.mShardList[(h >> 32) % ns].push_back(line);
+	q = (nl != nullptr) ? nl + 1 : chunk.mEnd;
       }
+    });
+
+  // エラーは最初に現れたものを逐次版と同じ形式で出力する．
+  for (ymuint t = 0; t < nt; ++ t) {
+    const Chunk& chunk = chunk_list[t];
+    if ( chunk.mErrLine > 0 ) {
+      if ( chunk.mErrPos == mVectSize ) {
+	cerr << "data length error at line " << chunk.mErrLine << endl;
+      }
+      else {
+	cerr << "illegal charactor at line "
+	     << chunk.mErrLine << ", column " << (chunk.mErrPos + 1) << endl;
+      }
+      return false;
     }
-    if ( vect_hash.check(rv) ) {
-      // 重複したデータ
-      delete_vector(rv);
+  }
+  if ( nr < k ) {
+    cerr << "read error" << endl;
+    return false;
+  }
+
+  // シャードごとに重複を調べる．
+  // 各シャードの行番号のリストはスレッド順に連結すれば昇順になる．
+  vector<ymuint8> dup_array(nr, 0);
+  vector<RvHash*> hash_list(ns, nullptr);
+  run_parallel(ns, [&](ymuint s) {
+      ymuint64 n = 0;
+      for (ymuint t = 0; t < nt; ++ t) {
+	n += chunk_list[t].mShardList[s].size();
+      }
+      RvHash* vect_hash = new RvHash(nblk, n);
+      for (ymuint t = 0; t < nt; ++ t) {
+	const Chunk& chunk = chunk_list[t];
+	const vector<ymuint64>& line_list = chunk.mShardList[s];
+	for (ymuint i = 0; i < line_list.size(); ++ i) {
+	  ymuint64 line = line_list[i];
+	  ymuint64 off = line - chunk.mLineBase;
+	  if ( !vect_hash->add(&chunk.mBody[off * nblk], chunk.mHash[off]) ) {
+	    dup_array[line] = 1;
+	  }
+	}
+      }
+      hash_list[s] = vect_hash;
+    });
+
+  mProbeNum = 0;
+  mProbeTotal = 0;
+  mProbeMax = 0;
+  for (ymuint s = 0; s < ns; ++ s) {
+    RvHash* vect_hash = hash_list[s];
+    mProbeNum += vect_hash->probe_num();
+    mProbeTotal += vect_hash->probe_total();
+    if ( mProbeMax < vect_hash->probe_max() ) {
+      mProbeMax = vect_hash->probe_max();
     }
-    else {
+    delete vect_hash;
+  }
+
+  // 出現順にインデックスを割り当てる．
+  // 範囲は行番号の順に並んでいるので，範囲の順にアリーナをたどればよい．
+  // コピーの済んだアリーナはすぐに解放する．
+  for (ymuint t = 0; t < nt; ++ t) {
+    Chunk& chunk = chunk_list[t];
+    ymuint64 cnt = chunk.mHash.size();
+    for (ymuint64 off = 0; off < cnt; ++ off) {
+      if ( dup_array[chunk.mLineBase + off] ) {
+	continue;
+      }
+      ymuint id = mVectList.size();
+      RegVect* rv = new_vector(id);
+      const ymuint64* body = &chunk.mBody[off * nblk];
+      for (ymuint i = 0; i < nblk; ++ i) {
+	rv->mBody[i] = body[i];
+      }
       mVectList.push_back(rv);
-      vect_hash.add(rv);
     }
+    vector<ymuint64>().swap(chunk.mBody);
+    vector<ymuint64>().swap(chunk.mHash);
+  }
+
+  return true;
+}
+
+// @brief 1行分のデータをベクタに変換して登録する．
+// @param[in] str 行の先頭
+// @param[in] len 行の長さ(改行は含まない)
+// @param[in] line 行番号(エラーメッセージ用)
+// @param[in] vect_hash 重複チェック用のハッシュ表
+// @retval true 変換が成功した．
+// @retval false 不正なデータだった．
+bool
+RvMgr::read_line(const char* str,
+		 ymuint len,
+		 ymuint line,
+		 RvHash& vect_hash)
+{
+  if ( len != mVectSize ) {
+    cerr << "data length error at line " << line << endl;
+    return false;
+  }
+
+  ymuint id = mVectList.size();
+  RegVect* rv = new_vector(id);
+  ymuint pos = rv_pack_bits(str, mVectSize, rv->mBody);
+  if ( pos < mVectSize ) {
+    cerr << "illegal charactor at line "
+	 << line << ", column " << (pos + 1) << endl;
+    delete_vector(rv);
+    return false;
+  }
+
+  if ( vect_hash.add(rv->mBody, RvHash::hash(rv->mBody, mBlockSize)) ) {
+    mVectList.push_back(rv);
+  }
+  else {
+    // 重複したデータ
+    delete_vector(rv);
   }
 
   return true;
 }
 
+// @brief 重複チェックの統計情報を記録する．
+// @param[in] vect_hash 重複チェックに用いたハッシュ表
+void
+RvMgr::set_hash_stats(const RvHash& vect_hash)
+{
+  mProbeNum = vect_hash.probe_num();
+  mProbeTotal = vect_hash.probe_total();
+  mProbeMax = vect_hash.probe_max();
+}
+
+// @brief 重複チェックの統計情報を出力する．
+// @param[in] s 出力先のストリーム
+void
+RvMgr::print_hash_stats(ostream& s) const
+{
+  double ave = 0.0;
+  if ( mProbeNum > 0 ) {
+    ave = static_cast<double>(mProbeTotal) / static_cast<double>(mProbeNum);
+  }
+  s << "# of lookups:         " << mProbeNum << endl
+    << "average probe length: " << ave << endl
+    << "max probe length:     " << mProbeMax << endl;
+}
+
+// @brief ベクタを連続した領域に格納した行列を得る．
+//
+// 最初に呼ばれた時に vect_list() から作られる．
+const RvMatrix&
+RvMgr::matrix() const
+{
+  if ( !mMatrixValid ) {
+    mMatrix.set(mVectList);
+    mMatrixValid = true;
+  }
+  return mMatrix;
+}
+
 // @brief 変数の価値を計算する．
 // @param[in] var 変数
 //
@@ -147,23 +635,7 @@ RvMgr::read_data(istream& s)
 double
 RvMgr::value(const Variable& var) const
 {
-  ymuint64 n0 = 0;
-  ymuint64 n1 = 0;
-  for (vector<const RegVect*>::const_iterator p = mVectList.begin();
-       p != mVectList.end(); ++ p) {
-    const RegVect* rv = *p;
-    if ( rv->classify(var) ) {
-      ++ n1;
-    }
-    else {
-      ++ n0;
-    }
-  }
-  ymuint64 nv = mVectList.size();
-  ymuint64 n_ideal = (nv * nv) / 4;
-  ymuint64 n = n0 * n1;
-  return static_cast<double>(n) / static_cast<double>(n_ideal);
-  //return static_cast<double>(n);
+  return var.value(matrix());
 }
 
 // @brief 変数対の価値を計算する．
@@ -174,35 +646,23 @@ double
 RvMgr::value(const Variable& var1,
 	     const Variable& var2) const
 {
-  ymuint64 n00 = 0;
-  ymuint64 n01 = 0;
-  ymuint64 n10 = 0;
-  ymuint64 n11 = 0;
-  for (vector<const RegVect*>::const_iterator p = mVectList.begin();
-       p != mVectList.end(); ++ p) {
-    const RegVect* rv = *p;
-    if ( rv->classify(var1) ) {
-      if ( rv->classify(var2) ) {
-	++ n11;
-      }
-      else {
-	++ n10;
-      }
-    }
-    else {
-      if ( rv->classify(var2) ) {
-	++ n01;
-      }
-      else {
-	++ n00;
-      }
-    }
-  }
-  ymuint64 nv = mVectList.size();
-  ymuint64 n_ideal = (nv * nv * 6) / 16;
-  ymuint64 n = n00 * (n01 + n10 + n11) + n01 * (n10 + n11) + n10 * n11;
-  return static_cast<double>(n) / static_cast<double>(n_ideal);
-  //return static_cast<double>(n);
+  vector<Variable> var_list(2);
+  var_list[0] = var1;
+  var_list[1] = var2;
+  return value(var_list);
+}
+
+// @brief 複数の変数の組の価値を計算する．
+// @param[in] var_list 変数のリスト
+//
+// 価値とはその変数の組で区別できる要素対の数
+double
+RvMgr::value(const vector<Variable>& var_list) const
+{
+  // 分類結果のビットベクタから各組み合わせの数を求める．
+  vector<ymuint64> hist;
+  matrix().joint_count(var_list, hist);
+  return Variable::calc_value(hist);
 }
 
 // @brief インデックスのサイズを得る．
@@ -293,45 +753,6 @@ RvMgr::dump(ostream& s) const
 // クラス RegVect
 //////////////////////////////////////////////////////////////////////
 
-BEGIN_NONAMESPACE
-
-inline
-ymuint
-parity64(ymuint64 data)
-{
-  ymuint64 data_a = data & 0x00000000FFFFFFFFULL;
-  ymuint64 data_b = data >> 32;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x000000000000FFFFULL;
-  data_b = data >> 16;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x00000000000000FFULL;
-  data_b = data >> 8;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x000000000000000FULL;
-  data_b = data >> 4;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x0000000000000007ULL;
-  data_b = data >> 3;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x0000000000000003ULL;
-  data_b = data >> 2;
-  data = data_a ^ data_b;
-
-  data_a = data & 0x0000000000000001ULL;
-  data_b = data >> 1;
-  data = data_a ^ data_b;
-
-  return data;
-}
-
-END_NONAMESPACE
-
 // @brief 分類する．
 // @param[in] var 分類用の変数
 //
@@ -344,7 +765,7 @@ RegVect::classify(const Variable& var) const
   ymuint nblk = (size() + 63) / 64;
   for (ymuint i = 0; i < nblk; ++ i) {
     ymuint64 tmp = var.raw_data(i) & mBody[i];
-    ans ^= parity64(tmp);
+    ans ^= RvMatrix::parity(tmp);
   }
   return ans;
 #else
@@ -358,19 +779,41 @@ RegVect::classify(const Variable& var) const
 #endif
 }
 
-// @brief ハッシュ値を返す．
+// @brief ブロック列で分類する．
+// @param[in] mask 分類用の変数のブロック列
+//
+// 0 か 1 を返す．
 ymuint
-RegVect::hash() const
+RegVect::classify(const ymuint64* mask) const
 {
-  ymuint val = 0;
+  ymuint64 tmp = 0ULL;
   ymuint nblk = (size() + 63) / 64;
   for (ymuint i = 0; i < nblk; ++ i) {
-    ymuint64 tmp = mBody[i];
-    ymuint val1 = tmp & 0xFFFFFFFFUL;
-    ymuint val2 = (tmp >> 32) & 0xFFFFFFFFUL;
-    val = val * 13 + val1 * 7 + val2;
+    tmp ^= mask[i] & mBody[i];
+  }
+  return RvMatrix::parity(tmp);
+}
+
+// @brief 疎な表現の変数で分類する．
+// @param[in] var 分類用の変数
+//
+// 0 か 1 を返す．
+ymuint
+RegVect::classify(const SparseVariable& var) const
+{
+  ymuint ans = 0;
+  for (ymuint i = 0; i < var.degree(); ++ i) {
+    ans ^= val(var.vid(i));
   }
-  return val;
+  return ans;
+}
+
+// @brief ハッシュ値を返す．
+ymuint64
+RegVect::hash() const
+{
+  ymuint nblk = (size() + 63) / 64;
+  return RvHash::hash(mBody, nblk);
 }
 
 // @brief 内容を出力する．
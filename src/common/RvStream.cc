@@ -0,0 +1,668 @@
+
+/// @file RvStream.cc
+/// @brief RvStream の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "RvStream.h"
+#include "RegVect.h"
+#include "Variable.h"
+#include "RvIo.h"
+#include "RvKernel.h"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <queue>
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 一度に併合する一時ファイルの数の上限
+const ymuint kMaxFanIn = 64;
+
+// 外部ソートの途中結果を保持するファイル
+//
+// 各レコードは [行番号, ブロック0, ブロック1, ...] の
+// 1 + nblk 個の ymuint64 からなる．
+struct RunFile
+{
+  // ファイル
+  FILE* mFp;
+
+  // レコード数
+  ymuint64 mNum;
+};
+
+// RunFile を先頭から順に読み出すクラス
+class RunReader
+{
+public:
+
+  // コンストラクタ
+  RunReader(const RunFile& run,
+	    ymuint rec_words) :
+    mFp(run.mFp),
+    mRemain(run.mNum),
+    mRec(rec_words)
+  {
+    std::rewind(mFp);
+  }
+
+  // 次のレコードを読み込む．
+  // もうなければ false を返す．
+  bool
+  next()
+  {
+    if ( mRemain == 0 ) {
+      return false;
+    }
+    -- mRemain;
+    return fread(&mRec[0], sizeof(ymuint64), mRec.size(), mFp) == mRec.size();
+  }
+
+  // 現在のレコードを返す．
+  const ymuint64*
+  rec() const
+  {
+    return &mRec[0];
+  }
+
+private:
+
+  // ファイル
+  FILE* mFp;
+
+  // 残りのレコード数
+  ymuint64 mRemain;
+
+  // 現在のレコード
+  vector<ymuint64> mRec;
+
+};
+
+// ブロックの内容を比較する．
+int
+cmp_body(const ymuint64* rec1,
+	 const ymuint64* rec2,
+	 ymuint nblk)
+{
+  for (ymuint i = 1; i <= nblk; ++ i) {
+    if ( rec1[i] != rec2[i] ) {
+      return rec1[i] < rec2[i] ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+// (内容, 行番号) の順序
+struct BodyLt
+{
+  BodyLt(ymuint nblk) : mNblk(nblk) { }
+
+  bool
+  operator()(const ymuint64* rec1,
+	     const ymuint64* rec2) const
+  {
+    int c = cmp_body(rec1, rec2, mNblk);
+    return c < 0 || (c == 0 && rec1[0] < rec2[0]);
+  }
+
+  ymuint mNblk;
+};
+
+// 行番号の順序
+struct LineLt
+{
+  bool
+  operator()(const ymuint64* rec1,
+	     const ymuint64* rec2) const
+  {
+    return rec1[0] < rec2[0];
+  }
+};
+
+// バッファ上のレコードを整列して一時ファイルに書き出す．
+// 一時ファイルが作れなかった時は mFp が nullptr の RunFile を返す．
+template<typename Lt>
+RunFile
+write_run(vector<ymuint64>& buff,
+	  ymuint64 num,
+	  ymuint rec_words,
+	  Lt lt)
+{
+  vector<const ymuint64*> rec_list(num);
+  for (ymuint64 i = 0; i < num; ++ i) {
+    rec_list[i] = &buff[i * rec_words];
+  }
+  sort(rec_list.begin(), rec_list.end(), lt);
+
+  RunFile run;
+  run.mFp = tmpfile();
+  run.mNum = num;
+  if ( run.mFp == nullptr ) {
+    cerr << "Could not create a temporary file" << endl;
+    return run;
+  }
+  for (ymuint64 i = 0; i < num; ++ i) {
+    fwrite(rec_list[i], sizeof(ymuint64), rec_words, run.mFp);
+  }
+  return run;
+}
+
+// 一時ファイルのレコードを併合しながら順に func に渡す．
+// 処理の終わった一時ファイルは閉じられる．
+template<typename Lt,
+	 typename Func>
+void
+merge_runs(vector<RunFile>& run_list,
+	   ymuint rec_words,
+	   Lt lt,
+	   Func func)
+{
+  ymuint nr = run_list.size();
+  vector<RunReader*> reader_list(nr);
+  for (ymuint i = 0; i < nr; ++ i) {
+    reader_list[i] = new RunReader(run_list[i], rec_words);
+  }
+
+  // 先頭のレコードが最小のものが top に来るヒープ
+  auto gt = [&](ymuint a, ymuint b) {
+    return lt(reader_list[b]->rec(), reader_list[a]->rec());
+  };
+  priority_queue<ymuint, vector<ymuint>, decltype(gt)> queue(gt);
+  for (ymuint i = 0; i < nr; ++ i) {
+    if ( reader_list[i]->next() ) {
+      queue.push(i);
+    }
+  }
+  while ( !queue.empty() ) {
+    ymuint i = queue.top();
+    queue.pop();
+    func(reader_list[i]->rec());
+    if ( reader_list[i]->next() ) {
+      queue.push(i);
+    }
+  }
+
+  for (ymuint i = 0; i < nr; ++ i) {
+    delete reader_list[i];
+    fclose(run_list[i].mFp);
+  }
+  run_list.clear();
+}
+
+// 整列済みの一時ファイルを併合の階層ごとに保持するクラス
+//
+// 同じ階層に kMaxFanIn 個溜まったら一つに併合して上の階層に移す．
+// そのため同時に開いている一時ファイルの数は
+// kMaxFanIn × 階層数 程度に抑えられる．
+template<typename Lt>
+class RunSet
+{
+public:
+
+  // コンストラクタ
+  RunSet(ymuint rec_words,
+	 Lt lt) :
+    mRecWords(rec_words),
+    mLt(lt)
+  {
+  }
+
+  // デストラクタ
+  // 残っている一時ファイルを閉じる．
+  ~RunSet()
+  {
+    for (ymuint l = 0; l < mLevelList.size(); ++ l) {
+      vector<RunFile>& run_list = mLevelList[l];
+      for (ymuint i = 0; i < run_list.size(); ++ i) {
+	fclose(run_list[i].mFp);
+      }
+    }
+  }
+
+  // 一時ファイルを加える．
+  // 一時ファイルが作れなかった時は false を返す．
+  bool
+  add(const RunFile& run)
+  {
+    if ( mLevelList.empty() ) {
+      mLevelList.resize(1);
+    }
+    mLevelList[0].push_back(run);
+    for (ymuint l = 0; mLevelList[l].size() >= kMaxFanIn; ++ l) {
+      RunFile run1;
+      if ( !merge_to_file(mLevelList[l], run1) ) {
+	return false;
+      }
+      if ( l + 1 == mLevelList.size() ) {
+	mLevelList.resize(l + 2);
+      }
+      mLevelList[l + 1].push_back(run1);
+    }
+    return true;
+  }
+
+  // 全ての一時ファイルを kMaxFanIn 個以下にまとめて run_list に移す．
+  // 一時ファイルが作れなかった時は false を返す．
+  bool
+  finish(vector<RunFile>& run_list)
+  {
+    run_list.clear();
+    for (ymuint l = 0; l < mLevelList.size(); ++ l) {
+      vector<RunFile>& run_list1 = mLevelList[l];
+      run_list.insert(run_list.end(), run_list1.begin(), run_list1.end());
+      run_list1.clear();
+    }
+    while ( run_list.size() > kMaxFanIn ) {
+      // 先頭の kMaxFanIn 個を一つにまとめて末尾に回す．
+      vector<RunFile> group(run_list.begin(), run_list.begin() + kMaxFanIn);
+      run_list.erase(run_list.begin(), run_list.begin() + kMaxFanIn);
+      RunFile run1;
+      if ( !merge_to_file(group, run1) ) {
+	// 残りはデストラクタで閉じる．
+	group.insert(group.end(), run_list.begin(), run_list.end());
+	mLevelList.assign(1, group);
+	run_list.clear();
+	return false;
+      }
+      run_list.push_back(run1);
+    }
+    return true;
+  }
+
+
+private:
+
+  // run_list を併合して一つの一時ファイルにする．
+  // run_list の一時ファイルは閉じられる．
+  bool
+  merge_to_file(vector<RunFile>& run_list,
+		RunFile& run)
+  {
+    run.mFp = tmpfile();
+    run.mNum = 0;
+    if ( run.mFp == nullptr ) {
+      cerr << "Could not create a temporary file" << endl;
+      return false;
+    }
+    merge_runs(run_list, mRecWords, mLt, [&](const ymuint64* rec) {
+	fwrite(rec, sizeof(ymuint64), mRecWords, run.mFp);
+	++ run.mNum;
+      });
+    return true;
+  }
+
+  // レコードのワード数
+  ymuint mRecWords;
+
+  // レコードの順序
+  Lt mLt;
+
+  // 階層ごとの一時ファイルのリスト
+  vector<vector<RunFile> > mLevelList;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス RvStream
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] chunk_size 一度にメモリ上に置くベクタ数
+RvStream::RvStream(ymuint chunk_size) :
+  mChunkSize(chunk_size),
+  mFile(nullptr)
+{
+  ASSERT_COND( chunk_size > 0 );
+  clear();
+}
+
+// @brief デストラクタ
+RvStream::~RvStream()
+{
+  clear();
+}
+
+// @brief テキスト形式のデータを読み込む．
+// @param[in] s 読み込み元のストリーム
+// @retval true 読み込みが成功した．
+// @retval false 読み込みが失敗した．
+//
+// 以下の3段階で処理を行う．
+// 1. mChunkSize 行ずつ読み込んで (内容, 行番号) で整列した
+//    一時ファイルを作る．
+//    一時ファイルは RunSet で kMaxFanIn 個ずつ併合していくので，
+//    同時に開くファイルの数は入力の大きさによらずほぼ一定となる．
+// 2. 1. の一時ファイルを併合して内容ごとに最初の行だけを残し，
+//    mChunkSize 個ずつ行番号で整列した一時ファイルを作る．
+// 3. 2. の一時ファイルを行番号順に併合してインデックスを割り当て，
+//    .rvb 形式で mFile に書き出す．
+bool
+RvStream::read_data(istream& s)
+{
+  clear();
+
+  // 最初の行はベクタのサイズと要素数(残りの行数)
+  string buf;
+  getline(s, buf);
+
+  const char* p = buf.c_str();
+  const char* end = p + buf.size();
+  ymuint n = rv_read_num(p, end);
+  ymuint k = rv_read_num(p, end);
+
+  set_size(n);
+
+  ymuint nblk = mBlockSize;
+  ymuint rec_words = nblk + 1;
+  vector<ymuint64> rec_buff(static_cast<ymuint64>(mChunkSize) * rec_words);
+
+  // エラーの時に途中の一時ファイルを閉じる．
+  auto close_runs = [](const vector<RunFile>& run_list) {
+    for (ymuint j = 0; j < run_list.size(); ++ j) {
+      fclose(run_list[j].mFp);
+    }
+  };
+
+  // 1. 内容で整列した一時ファイルを作る．
+  RunSet<BodyLt> run_set(rec_words, BodyLt(nblk));
+  for (ymuint i = 0; i < k; ) {
+    ymuint64 c = 0;
+    for ( ; c < mChunkSize && i < k; ++ c, ++ i) {
+      bool error = false;
+      if ( !getline(s, buf) ) {
+	cerr << "read error" << endl;
+	error = true;
+      }
+      else if ( buf.size() != n ) {
+	cerr << "data length error at line " << (i + 1) << endl;
+	error = true;
+      }
+      else {
+	ymuint64* rec = &rec_buff[c * rec_words];
+	rec[0] = i;
+	for (ymuint j = 1; j <= nblk; ++ j) {
+	  rec[j] = 0ULL;
+	}
+	ymuint pos = rv_pack_bits(buf.c_str(), n, rec + 1);
+	if ( pos < n ) {
+	  cerr << "illegal charactor at line "
+	       << (i + 1) << ", column " << (pos + 1) << endl;
+	  error = true;
+	}
+      }
+      if ( error ) {
+	clear();
+	return false;
+      }
+    }
+    RunFile run = write_run(rec_buff, c, rec_words, BodyLt(nblk));
+    if ( run.mFp == nullptr || !run_set.add(run) ) {
+      clear();
+      return false;
+    }
+  }
+  vector<RunFile> run_list;
+  if ( !run_set.finish(run_list) ) {
+    clear();
+    return false;
+  }
+
+  // 2. 重複を取り除き，行番号で整列した一時ファイルを作る．
+  RunSet<LineLt> run2_set(rec_words, LineLt());
+  ymuint64 c = 0;
+  ymuint64 nu = 0;
+  vector<ymuint64> last_rec(rec_words);
+  bool first = true;
+  bool tmp_error = false;
+  auto put_run2 = [&](ymuint64 num) {
+    RunFile run = write_run(rec_buff, num, rec_words, LineLt());
+    if ( run.mFp == nullptr || !run2_set.add(run) ) {
+      tmp_error = true;
+    }
+  };
+  merge_runs(run_list, rec_words, BodyLt(nblk), [&](const ymuint64* rec) {
+      if ( !first && cmp_body(rec, &last_rec[0], nblk) == 0 ) {
+	// 重複したデータ
+	return;
+      }
+      first = false;
+      copy(rec, rec + rec_words, last_rec.begin());
+      copy(rec, rec + rec_words, rec_buff.begin() + c * rec_words);
+      ++ c;
+      ++ nu;
+      if ( c == mChunkSize ) {
+	put_run2(c);
+	c = 0;
+      }
+    });
+  if ( c > 0 ) {
+    put_run2(c);
+  }
+  vector<RunFile> run2_list;
+  if ( tmp_error || !run2_set.finish(run2_list) ) {
+    close_runs(run2_list);
+    clear();
+    return false;
+  }
+
+  // 3. 出現順にインデックスを割り当てる．
+  mFile = tmpfile();
+  if ( mFile == nullptr ) {
+    cerr << "Could not create a temporary file" << endl;
+    close_runs(run2_list);
+    clear();
+    return false;
+  }
+  RvbHeader header;
+  memcpy(header.mMagic, rvb_magic, sizeof(rvb_magic));
+  header.mVectSize = mVectSize;
+  header.mBlockSize = mBlockSize;
+  header.mRecSize = mRvSize;
+  header.mNum = nu;
+  header.mReserved = 0;
+  fwrite(&header, sizeof(header), 1, mFile);
+
+  vector<ymuint64> image(mRvSize / sizeof(ymuint64));
+  ymuint id = 0;
+  merge_runs(run2_list, rec_words, LineLt(), [&](const ymuint64* rec) {
+      RegVect* rv = new (&image[0]) RegVect(mVectSize, id);
+      for (ymuint j = 0; j < nblk; ++ j) {
+	rv->mBody[j] = rec[j + 1];
+      }
+      fwrite(&image[0], 1, mRvSize, mFile);
+      ++ id;
+    });
+  mVectNum = nu;
+
+  rewind();
+
+  return true;
+}
+
+// @brief バイナリ形式(.rvb)のファイルを開く．
+// @param[in] filename ファイル名
+// @retval true 成功した．
+// @retval false 失敗した．
+bool
+RvStream::open_binary(const string& filename)
+{
+  clear();
+
+  mFile = fopen(filename.c_str(), "rb");
+  if ( mFile == nullptr ) {
+    cerr << "Could not open " << filename << endl;
+    return false;
+  }
+
+  RvbHeader header;
+  if ( fread(&header, sizeof(header), 1, mFile) != 1 ||
+       memcmp(header.mMagic, rvb_magic, sizeof(rvb_magic)) != 0 ) {
+    cerr << filename << ": not a rvb file" << endl;
+    clear();
+    return false;
+  }
+
+  // ベクタ数 × レコード長 が溢れないように割り算で比べる．
+  set_size(header.mVectSize);
+  ymuint64 k = header.mNum;
+  bool ok = header.mVectSize > 0 &&
+    header.mBlockSize == mBlockSize && header.mRecSize == mRvSize &&
+    fseeko(mFile, 0, SEEK_END) == 0;
+  if ( ok ) {
+    ymuint64 size = ftello(mFile);
+    ok = size >= sizeof(RvbHeader) &&
+      k <= (size - sizeof(RvbHeader)) / mRvSize;
+  }
+  if ( !ok ) {
+    cerr << filename << ": broken rvb file" << endl;
+    clear();
+    return false;
+  }
+  mVectNum = k;
+
+  rewind();
+
+  return true;
+}
+
+// @brief インデックスのサイズを得る．
+ymuint
+RvStream::index_size() const
+{
+  ymuint64 k = mVectNum;
+  ++ k;
+  ymuint ans = 0;
+  ymuint64 m = 1;
+  while ( m < k ) {
+    ++ ans;
+    m <<= 1;
+  }
+  return ans;
+}
+
+// @brief 先頭のチャンクに戻る．
+void
+RvStream::rewind()
+{
+  mChunk.clear();
+  mReadNum = 0;
+  if ( mFile != nullptr ) {
+    fseek(mFile, sizeof(RvbHeader), SEEK_SET);
+  }
+}
+
+// @brief 次のチャンクを読み込む．
+// @retval true 読み込んだ．
+// @retval false もうベクタが残っていなかった．
+bool
+RvStream::next_chunk()
+{
+  mChunk.clear();
+  if ( mReadNum >= mVectNum ) {
+    return false;
+  }
+
+  ymuint64 num = mVectNum - mReadNum;
+  if ( num > mChunkSize ) {
+    num = mChunkSize;
+  }
+  ymuint64 nbytes = num * mRvSize;
+  mBuff.resize(nbytes / sizeof(ymuint64));
+  if ( fread(&mBuff[0], 1, nbytes, mFile) != nbytes ) {
+    cerr << "read error" << endl;
+    mReadNum = mVectNum;
+    return false;
+  }
+  mReadNum += num;
+
+  // レコードを直接 RegVect として参照する．
+  const char* rec = reinterpret_cast<const char*>(&mBuff[0]);
+  mChunk.reserve(num);
+  for (ymuint64 i = 0; i < num; ++ i, rec += mRvSize) {
+    mChunk.push_back(reinterpret_cast<const RegVect*>(rec));
+  }
+
+  return true;
+}
+
+// @brief 変数の価値を計算する．
+// @param[in] var 変数
+//
+// RvMgr::value() と同じ値をチャンクごとの走査で求める．
+// 呼び出し側の走査を乱さないように，読み込み位置を保存しておき，
+// chunk() とは別のバッファに読み込む．
+// バッファはレコードが連続しているので
+// mBody の先頭からレコード間隔で直接分類する．
+double
+RvStream::value(const Variable& var)
+{
+  vector<ymuint64> mask(mBlockSize);
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mask[i] = var.raw_data(i);
+  }
+  ymuint64 stride = mRvSize / sizeof(ymuint64);
+  ymuint64 body_offset = offsetof(RegVect, mBody) / sizeof(ymuint64);
+  vector<ymuint64> buff;
+  ymuint64 n1 = 0;
+  if ( mFile != nullptr ) {
+    off_t pos = ftello(mFile);
+    fseeko(mFile, sizeof(RvbHeader), SEEK_SET);
+    for (ymuint64 base = 0; base < mVectNum; base += mChunkSize) {
+      ymuint64 num = mVectNum - base;
+      if ( num > mChunkSize ) {
+	num = mChunkSize;
+      }
+      ymuint64 nbytes = num * mRvSize;
+      buff.resize(nbytes / sizeof(ymuint64));
+      if ( fread(&buff[0], 1, nbytes, mFile) != nbytes ) {
+	cerr << "read error" << endl;
+	break;
+      }
+      n1 += rv_count1_rows(&buff[body_offset], stride, mBlockSize, num, &mask[0]);
+    }
+    fseeko(mFile, pos, SEEK_SET);
+  }
+  ymuint64 nv = mVectNum;
+  ymuint64 n0 = nv - n1;
+  ymuint64 n_ideal = (nv * nv) / 4;
+  ymuint64 n = n0 * n1;
+  return static_cast<double>(n) / static_cast<double>(n_ideal);
+}
+
+// @brief 一時ファイルを閉じて初期状態に戻す．
+void
+RvStream::clear()
+{
+  if ( mFile != nullptr ) {
+    fclose(mFile);
+    mFile = nullptr;
+  }
+  mVectSize = 0;
+  mBlockSize = 0;
+  mRvSize = 0;
+  mVectNum = 0;
+  mReadNum = 0;
+  mBuff.clear();
+  mChunk.clear();
+}
+
+// @brief ベクタのサイズを設定する．
+void
+RvStream::set_size(ymuint size)
+{
+  mVectSize = size;
+  mBlockSize = (size + 63) / 64;
+  mRvSize = sizeof(RegVect) + 8 * (mBlockSize - 1);
+}
+
+END_NAMESPACE_IGF
@@ -9,7 +9,10 @@
 
 #include "SigFunc.h"
 #include "Variable.h"
+#include "VarTable.h"
+#include "SparseVariable.h"
 #include "RegVect.h"
+#include "RvMatrix.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -21,20 +24,71 @@ BEGIN_NAMESPACE_IGF
 // @brief コンストラクタ
 // @param[in] var_list 変数のリスト
 SigFunc::SigFunc(const vector<Variable>& var_list) :
-  mVarList(var_list)
+  mIdList(var_list.size())
 {
+  mOwnTable = new VarTable;
+  mVarTable = mOwnTable;
+  for (ymuint i = 0; i < var_list.size(); ++ i) {
+    mIdList[i] = mOwnTable->intern(var_list[i]);
+  }
+  init_sparse();
+}
+
+// @brief 変数の表を共有するコンストラクタ
+// @param[in] var_table 変数の表
+// @param[in] id_list 変数の番号のリスト
+SigFunc::SigFunc(const VarTable& var_table,
+		 const vector<ymuint>& id_list) :
+  mVarTable(&var_table),
+  mOwnTable(nullptr),
+  mIdList(id_list)
+{
+  init_sparse();
 }
 
 // @brief デストラクタ
 SigFunc::~SigFunc()
 {
+  delete mOwnTable;
 }
 
 // @brief 出力のビット幅を返す．
 ymuint
 SigFunc::output_width() const
 {
-  return mVarList.size();
+  return mIdList.size();
+}
+
+// @brief 出力ビットの変数を返す．
+// @param[in] pos 出力ビット ( 0 <= pos < output_width() )
+Variable
+SigFunc::var(ymuint pos) const
+{
+  return mVarTable->var(mIdList[pos]);
+}
+
+// @brief 疎な表現を用意する．
+//
+// 次数の低い出力は疎な表現で分類する．
+// 1行ずつの分類と列の XOR では基準が異なる．
+void
+SigFunc::init_sparse()
+{
+  ymuint n = mIdList.size();
+  mSparseList.clear();
+  mSparseList.resize(n);
+  mRowSparse.clear();
+  mRowSparse.resize(n, false);
+  mColumnSparse.clear();
+  mColumnSparse.resize(n, false);
+  for (ymuint i = 0; i < n; ++ i) {
+    Variable var1 = var(i);
+    mRowSparse[i] = SparseVariable::is_preferred_row(var1);
+    mColumnSparse[i] = SparseVariable::is_preferred_column(var1);
+    if ( mRowSparse[i] || mColumnSparse[i] ) {
+      mSparseList[i] = var1;
+    }
+  }
 }
 
 // @brief 関数値を求める．
@@ -43,23 +97,73 @@ ymuint
 SigFunc::eval(const RegVect* rv) const
 {
   ymuint ans = 0U;
-  for (ymuint i = 0; i < mVarList.size(); ++ i) {
-    const Variable& var = mVarList[i];
-    if ( rv->classify(var) ) {
+  for (ymuint i = 0; i < mIdList.size(); ++ i) {
+    ymuint c = mRowSparse[i] ? rv->classify(mSparseList[i]) :
+      rv->classify(mVarTable->body(mIdList[i]));
+    if ( c ) {
+      ans |= (1U << i);
+    }
+  }
+  return ans;
+}
+
+// @brief 関数値を求める．
+// @param[in] rv_mat 登録ベクタの行列
+// @param[in] pos 行番号
+ymuint
+SigFunc::eval(const RvMatrix& rv_mat,
+	      ymuint pos) const
+{
+  ymuint ans = 0U;
+  for (ymuint i = 0; i < mIdList.size(); ++ i) {
+    ymuint c = mRowSparse[i] ? rv_mat.classify(pos, mSparseList[i]) :
+      rv_mat.classify(pos, mVarTable->body(mIdList[i]));
+    if ( c ) {
       ans |= (1U << i);
     }
   }
   return ans;
 }
 
+// @brief すべての行の関数値を求める．
+// @param[in] rv_mat 登録ベクタの行列
+// @param[out] val_list 関数値を格納するリスト
+void
+SigFunc::eval_all(const RvMatrix& rv_mat,
+		  vector<ymuint>& val_list) const
+{
+  ymuint nv = rv_mat.vect_num();
+  val_list.clear();
+  val_list.resize(nv, 0U);
+  if ( nv == 0 ) {
+    return;
+  }
+  vector<ymuint64> bits(rv_mat.column_size());
+  for (ymuint i = 0; i < mIdList.size(); ++ i) {
+    // 疎な表現の場合は列の XOR で求める．
+    if ( mColumnSparse[i] ) {
+      rv_mat.classify_all(mSparseList[i], &bits[0]);
+    }
+    else {
+      // 表のブロック列を直接渡して Variable の復元を避ける．
+      rv_mat.classify_rows(mVarTable->body(mIdList[i]), 0, nv, &bits[0]);
+    }
+    for (ymuint pos = 0; pos < nv; ++ pos) {
+      if ( (bits[pos / 64] >> (pos % 64)) & 1ULL ) {
+	val_list[pos] |= (1U << i);
+      }
+    }
+  }
+}
+
 // @brief 内容を表示する．
 // @param[in] s 出力先のストリーム
 void
 SigFunc::dump(ostream& s) const
 {
-  for (ymuint i = 0; i < mVarList.size(); ++ i) {
-    const Variable& var = mVarList[i];
-    s << "#" << i << ": " << var << endl;
+  for (ymuint i = 0; i < mIdList.size(); ++ i) {
+    Variable var1 = var(i);
+    s << "#" << i << ": " << var1 << endl;
   }
 }
 
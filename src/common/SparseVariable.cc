@@ -0,0 +1,80 @@
+
+/// @file SparseVariable.cc
+/// @brief SparseVariable の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "SparseVariable.h"
+#include "Variable.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス SparseVariable
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+SparseVariable::SparseVariable() :
+  mVarNum(0)
+{
+}
+
+// @brief Variable からの変換コンストラクタ
+// @param[in] var 変数
+SparseVariable::SparseVariable(const Variable& var) :
+  mVarNum(var.var_size()),
+  mVidList(var.vid_list())
+{
+}
+
+// @brief デストラクタ
+SparseVariable::~SparseVariable()
+{
+}
+
+// @brief Variable に変換する．
+//
+// 次数が 0 の場合はどのビットも立っていない変数を返す．
+Variable
+SparseVariable::dense() const
+{
+  if ( mVarNum == 0 ) {
+    return Variable();
+  }
+  if ( mVidList.empty() ) {
+    // 同じ変数を2回合成すると打ち消し合う．
+    Variable var(mVarNum, 0);
+    var *= Variable(mVarNum, 0);
+    return var;
+  }
+  Variable var(mVarNum, mVidList[0]);
+  for (ymuint i = 1; i < mVidList.size(); ++ i) {
+    var *= Variable(mVarNum, mVidList[i]);
+  }
+  return var;
+}
+
+// @brief 1行ずつの分類で疎な表現を用いたほうがよい時 true を返す．
+// @param[in] var 変数
+bool
+SparseVariable::is_preferred_row(const Variable& var)
+{
+  return var.degree() <= (var.var_size() + 63) / 64;
+}
+
+// @brief 列の XOR による全行の分類で疎な表現を用いたほうがよい時 true を返す．
+// @param[in] var 変数
+//
+// 2 × 次数 × nv / 64 <= nv × (ブロック数 + 1) を変形している．
+bool
+SparseVariable::is_preferred_column(const Variable& var)
+{
+  ymuint nblk = (var.var_size() + 63) / 64;
+  return var.degree() <= 32 * (nblk + 1);
+}
+
+END_NAMESPACE_IGF
@@ -36,17 +36,37 @@ void
 VarPool::put(const Variable& var,
 	     double value)
 {
-  if ( mHashTable.find(var) ) {
+  if ( mHeapSize == 0 ) {
+    return;
+  }
+  if ( mVarNum == mHeapSize && value <= mHeap[0].mValue ) {
+    // 最も価値の低いものより良くない．
+    return;
+  }
+
+  // 表への登録はヒープ木に入れると決まってから行う．
+  ymuint id = mVarTable.find(var);
+  if ( id != VarTable::kNoId && mInHeap[id] ) {
     // 同じものがすでに入っていた．
     return;
   }
+  if ( id == VarTable::kNoId ) {
+    if ( mVarTable.num() >= mHeapSize * 4 ) {
+      // 追い出された変数が溜まったので表を作り直す．
+      compact();
+    }
+    id = mVarTable.intern(var);
+    if ( id >= mInHeap.size() ) {
+      mInHeap.resize(id + 1, false);
+    }
+  }
 
   if ( mVarNum == mHeapSize ) {
     // 一杯だった．
-    // 先頭の要素を捨てる．
-    mHashTable.erase(mHeap[0].mVar);
+    // 先頭(価値最小)の要素を捨てる．
+    mInHeap[mHeap[0].mId] = false;
     // 代わりに新しい変数を入れる．
-    mHeap[0].mVar = var;
+    mHeap[0].mId = id;
     mHeap[0].mValue = value;
     // 適切な位置まで降ろす．
     move_down(0);
@@ -55,12 +75,25 @@ VarPool::put(const Variable& var,
     // 末尾に追加して上に上げる．
     ymuint pos = mVarNum;
     ++ mVarNum;
-    mHeap[pos].mVar = var;
+    mHeap[pos].mId = id;
     mHeap[pos].mValue = value;
     move_up(pos);
   }
-  // ハッシュに登録する．
-  mHashTable.add(var);
+  mInHeap[id] = true;
+}
+
+// @brief 変数の表をヒープ木中の変数のみで作り直す．
+void
+VarPool::compact()
+{
+  VarTable new_table(mVarTable.var_size());
+  for (ymuint pos = 0; pos < mVarNum; ++ pos) {
+    Node& node = mHeap[pos];
+    node.mId = new_table.intern(mVarTable.body(node.mId));
+  }
+  mVarTable = std::move(new_table);
+  mInHeap.clear();
+  mInHeap.resize(mVarNum, true);
 }
 
 // @brief 変数を適当な位置まで沈める．
@@ -143,8 +176,7 @@ VarPool::print(ostream& s)
   s << "*** VarPool ***" << endl
     << " size() = " << size() << endl;
   for (ymuint i = 0; i < size(); ++ i) {
-    const Variable& var1 = var(i);
-    s << var1 << ": value = " << mHeap[i].mValue << endl;
+    s << var(i) << ": value = " << mHeap[i].mValue << endl;
   }
   s << endl;
 }
@@ -0,0 +1,186 @@
+
+/// @file VarTable.cc
+/// @brief VarTable の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "VarTable.h"
+#include "Variable.h"
+#include "RvHash.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス VarTable
+//////////////////////////////////////////////////////////////////////
+
+// 存在しない番号を表す値
+const ymuint VarTable::kNoId;
+
+// @brief コンストラクタ
+// @param[in] var_num 変数の総数
+VarTable::VarTable(ymuint var_num)
+{
+  clear(var_num);
+}
+
+// @brief デストラクタ
+VarTable::~VarTable()
+{
+}
+
+// @brief 内容を空にする．
+// @param[in] var_num 変数の総数
+void
+VarTable::clear(ymuint var_num)
+{
+  mVarSize = var_num;
+  mBlockSize = (var_num + 63) / 64;
+  mBody.clear();
+  mHashArray.clear();
+  mTmpBody.resize(mBlockSize);
+  alloc_table(64);
+}
+
+// @brief 変数を登録する．
+// @param[in] var 変数
+// @return 変数の番号を返す．
+ymuint
+VarTable::intern(const Variable& var)
+{
+  if ( mVarSize == 0 && num() == 0 ) {
+    clear(var.var_size());
+  }
+  ASSERT_COND( var.var_size() == mVarSize );
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mTmpBody[i] = var.raw_data(i);
+  }
+  return intern_body(mTmpBody.data());
+}
+
+// @brief ブロック列を変数として登録する．
+// @param[in] body ブロック列
+// @return 変数の番号を返す．
+ymuint
+VarTable::intern(const ymuint64* body)
+{
+  ASSERT_COND( mVarSize > 0 );
+  return intern_body(body);
+}
+
+// @brief 2つの変数を合成した変数を登録する．
+// @param[in] id1, id2 変数の番号
+// @return 合成した変数の番号を返す．
+ymuint
+VarTable::compose(ymuint id1,
+		  ymuint id2)
+{
+  const ymuint64* body1 = body(id1);
+  const ymuint64* body2 = body(id2);
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mTmpBody[i] = body1[i] ^ body2[i];
+  }
+  return intern_body(mTmpBody.data());
+}
+
+// @brief 変数を探す．
+// @param[in] var 変数
+// @return 変数の番号を返す．
+ymuint
+VarTable::find(const Variable& var) const
+{
+  if ( var.var_size() != mVarSize ) {
+    return kNoId;
+  }
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mTmpBody[i] = var.raw_data(i);
+  }
+  ymuint64 h = RvHash::hash(mTmpBody.data(), mBlockSize);
+  return mTable[lookup(mTmpBody.data(), h)];
+}
+
+// @brief 変数を返す．
+// @param[in] id 変数の番号 ( 0 <= id < num() )
+Variable
+VarTable::var(ymuint id) const
+{
+  return Variable(body(id), mVarSize);
+}
+
+// @brief ブロック列を登録する．
+// @param[in] body ブロック列
+// @return 番号を返す．
+ymuint
+VarTable::intern_body(const ymuint64* body)
+{
+  ymuint64 h = RvHash::hash(body, mBlockSize);
+  ymuint64 pos = lookup(body, h);
+  if ( mTable[pos] != kNoId ) {
+    return mTable[pos];
+  }
+
+  ymuint id = num();
+  mBody.insert(mBody.end(), body, body + mBlockSize);
+  mHashArray.push_back(h);
+  mTable[pos] = id;
+
+  // 負荷率が 1/2 を超えたら拡張する．
+  if ( num() * 2 > mTable.size() ) {
+    alloc_table(mTable.size() * 2);
+  }
+  return id;
+}
+
+// @brief ブロック列を探す．
+// @param[in] body ブロック列
+// @param[in] h body のハッシュ値
+// @return ハッシュ表の位置を返す．
+ymuint64
+VarTable::lookup(const ymuint64* body,
+		 ymuint64 h) const
+{
+  for (ymuint64 pos = h & mMask; ; pos = (pos + 1) & mMask) {
+    ymuint id = mTable[pos];
+    if ( id == kNoId ) {
+      return pos;
+    }
+    if ( mHashArray[id] == h ) {
+      const ymuint64* body1 = mBody.data() + static_cast<ymuint64>(id) * mBlockSize;
+      bool found = true;
+      for (ymuint i = 0; i < mBlockSize; ++ i) {
+	if ( body1[i] != body[i] ) {
+	  found = false;
+	  break;
+	}
+      }
+      if ( found ) {
+	return pos;
+      }
+    }
+  }
+}
+
+// @brief ハッシュ表を確保する．
+// @param[in] size サイズ(2のべき乗)
+//
+// 登録済みの番号は入れ直す．
+void
+VarTable::alloc_table(ymuint64 size)
+{
+  mTable.clear();
+  mTable.resize(size, kNoId);
+  mMask = size - 1;
+  for (ymuint id = 0; id < num(); ++ id) {
+    ymuint64 pos = mHashArray[id] & mMask;
+    while ( mTable[pos] != kNoId ) {
+      pos = (pos + 1) & mMask;
+    }
+    mTable[pos] = id;
+  }
+}
+
+END_NAMESPACE_IGF
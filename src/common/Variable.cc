@@ -9,6 +9,7 @@
 
 #include "Variable.h"
 #include "RegVect.h"
+#include "RvMatrix.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -43,10 +44,53 @@ Variable::sft(ymuint vid)
   return vid % 64;
 }
 
+// @brief mVarNum に合わせてビットベクタの領域を用意する．
+void
+Variable::alloc_body()
+{
+  if ( mVarNum <= kInlineSize ) {
+    mBitVect = mInlineBody;
+  }
+  else {
+    mBitVect = new ymuint64[nblk()];
+  }
+}
+
+// @brief ビットベクタの領域を解放する．
+void
+Variable::free_body()
+{
+  if ( mBitVect != mInlineBody ) {
+    delete [] mBitVect;
+  }
+  mBitVect = mInlineBody;
+}
+
+// @brief src の内容を奪う．
+// @param[in] src ムーブ元のオブジェクト
+//
+// 自身の領域は解放済みであること．
+void
+Variable::steal(Variable& src)
+{
+  mVarNum = src.mVarNum;
+  if ( src.mBitVect == src.mInlineBody ) {
+    mBitVect = mInlineBody;
+    for (ymuint i = 0; i < nblk(); ++ i) {
+      mInlineBody[i] = src.mInlineBody[i];
+    }
+  }
+  else {
+    mBitVect = src.mBitVect;
+  }
+  src.mVarNum = 0;
+  src.mBitVect = src.mInlineBody;
+}
+
 // @brief 空のコンストラクタ
 Variable::Variable() :
   mVarNum(0),
-  mBitVect(nullptr)
+  mBitVect(mInlineBody)
 {
 }
 
@@ -57,24 +101,44 @@ Variable::Variable(ymuint var_num,
 		   ymuint vid) :
   mVarNum(var_num)
 {
-  mBitVect = new ymuint64[nblk()];
+  alloc_body();
   for (ymuint i = 0; i < nblk(); ++ i) {
     mBitVect[i] = 0ULL;
   }
   mBitVect[blk(vid)] |= (1ULL << sft(vid));
 }
 
+// @brief ビットベクタを指定したコンストラクタ
+// @param[in] body ブロック列((var_num + 63) / 64 個)
+// @param[in] var_num 変数の総数
+Variable::Variable(const ymuint64* body,
+		   ymuint var_num) :
+  mVarNum(var_num)
+{
+  alloc_body();
+  for (ymuint i = 0; i < nblk(); ++ i) {
+    mBitVect[i] = body[i];
+  }
+}
+
 // @brief コピーコンストラクタ
 // @param[in] src コピー元のオブジェクト
 Variable::Variable(const Variable& src) :
   mVarNum(src.mVarNum)
 {
-  mBitVect = new ymuint64[nblk()];
+  alloc_body();
   for (ymuint i = 0; i < nblk(); ++ i) {
     mBitVect[i] = src.mBitVect[i];
   }
 }
 
+// @brief ムーブコンストラクタ
+// @param[in] src ムーブ元のオブジェクト
+Variable::Variable(Variable&& src) noexcept
+{
+  steal(src);
+}
+
 // @brief 代入演算子
 // @param[in] src コピー元のオブジェクト
 const Variable&
@@ -82,9 +146,9 @@ Variable::operator=(const Variable& src)
 {
   if ( &src != this ) {
     if ( mVarNum != src.mVarNum ) {
+      free_body();
       mVarNum = src.mVarNum;
-      delete [] mBitVect;
-      mBitVect = new ymuint64[nblk()];
+      alloc_body();
     }
     for (ymuint i = 0; i < nblk(); ++ i) {
       mBitVect[i] = src.mBitVect[i];
@@ -93,10 +157,22 @@ Variable::operator=(const Variable& src)
   return *this;
 }
 
+// @brief ムーブ代入演算子
+// @param[in] src ムーブ元のオブジェクト
+const Variable&
+Variable::operator=(Variable&& src) noexcept
+{
+  if ( &src != this ) {
+    free_body();
+    steal(src);
+  }
+  return *this;
+}
+
 // @brief デストラクタ
 Variable::~Variable()
 {
-  delete [] mBitVect;
+  free_body();
 }
 
 // @brief 変数空間のサイズを返す．
@@ -123,14 +199,26 @@ vector<ymuint>
 Variable::vid_list() const
 {
   vector<ymuint> vlist;
-  for (ymuint i = 0; i < mVarNum; ++ i) {
-    if ( mBitVect[blk(i)] & (1UL << sft(i)) ) {
-      vlist.push_back(i);
+  vlist.reserve(degree());
+  for (ymuint i = 0; i < nblk(); ++ i) {
+    for (ymuint64 tmp = mBitVect[i]; tmp != 0ULL; tmp &= (tmp - 1)) {
+      vlist.push_back(i * 64 + __builtin_ctzll(tmp));
     }
   }
   return vlist;
 }
 
+// @brief 次数(含まれる変数の数)を返す．
+ymuint
+Variable::degree() const
+{
+  ymuint n = 0;
+  for (ymuint i = 0; i < nblk(); ++ i) {
+    n += __builtin_popcountll(mBitVect[i]);
+  }
+  return n;
+}
+
 // @brief ビットベクタの生データを返す．
 // @param[in] pos ブロック番号
 ymuint64
@@ -162,7 +250,9 @@ Variable
 operator*(const Variable& left,
 	  const Variable& right)
 {
-  return Variable(left).operator*=(right);
+  Variable ans(left);
+  ans *= right;
+  return ans;
 }
 
 // @brief 共通要素を持つとき true を返す．
@@ -201,12 +291,55 @@ Variable::value(const vector<const RegVect*>& rv_list) const
       ++ n0;
     }
   }
-  ymuint64 nv = rv_list.size();
+  return calc_value(n0, n1);
+}
+
+// @brief ベクタ集合に対する価値を計算する．
+// @param[in] rv_mat ベクタの行列
+// @return 価値を返す．
+//
+// 分類は rv_mat の転置した列の XOR で行う．
+double
+Variable::value(const RvMatrix& rv_mat) const
+{
+  ymuint64 nv = rv_mat.vect_num();
+  ymuint64 n1 = rv_mat.count1(*this);
+  return calc_value(nv - n1, n1);
+}
+
+// @brief 分類結果から価値を計算する．
+// @param[in] n0 0 に分類されたベクタ数
+// @param[in] n1 1 に分類されたベクタ数
+double
+Variable::calc_value(ymuint64 n0,
+		     ymuint64 n1)
+{
+  ymuint64 nv = n0 + n1;
   ymuint64 n_ideal = (nv * nv) / 4;
   ymuint64 n = n0 * n1;
   return static_cast<double>(n) / static_cast<double>(n_ideal);
 }
 
+// @brief 複数の変数による分類の同時分布から価値を計算する．
+// @param[in] hist 同時分布(要素数は 2 のべき乗)
+double
+Variable::calc_value(const vector<ymuint64>& hist)
+{
+  ymuint np = hist.size();
+  ymuint64 nv = 0;
+  ymuint64 nsq = 0;
+  for (ymuint p = 0; p < np; ++ p) {
+    ymuint64 c = hist[p];
+    nv += c;
+    nsq += c * c;
+  }
+  // 区別できる要素対の数は全体の対の数から
+  // 同じパタンに分類された対の数を引いたもの
+  ymuint64 n = (nv * nv - nsq) / 2;
+  ymuint64 n_ideal = (nv * nv * (np - 1)) / (np * 2);
+  return static_cast<double>(n) / static_cast<double>(n_ideal);
+}
+
 // @brief ハッシュ値を返す．
 ymuint
 Variable::hash() const
@@ -154,13 +154,12 @@ igugen(int argc,
 
   RvMgr rv_mgr;
 
-  ifstream ifs(args[0]);
-  if ( !ifs ) {
-    cerr << "Could not open " << args[0] << endl;
-    return 1;
-  }
-
-  if ( !rv_mgr.read_data(ifs) ) {
+  // 拡張子が .rvb のファイルはバイナリ形式としてマップする．
+  const string& filename = args[0];
+  bool rvb = filename.size() > 4 &&
+    filename.compare(filename.size() - 4, 4, ".rvb") == 0;
+  bool stat = rvb ? rv_mgr.map_binary(filename) : rv_mgr.read_data(filename);
+  if ( !stat ) {
     cerr << "Error in reading " << args[0] << endl;
     return 1;
   }
@@ -173,12 +172,16 @@ igugen(int argc,
   if ( lx_str != string() ) {
     LxGen* lxgen = LxGen::new_obj(lx_str);
     lxgen->generate(rv_mgr.vect_list(), n_basis, var_list);
+    if ( lxgen->full_rank() > 0 ) {
+      cout << "rank:            " << lxgen->rank()
+	   << " / " << lxgen->full_rank() << endl;
+    }
   }
   else {
     ymuint ni = rv_mgr.vect_size();
     for (ymuint i = 0; i < ni; ++ i) {
       Variable var1(ni, i);
-      double val = var1.value(rv_mgr.vect_list());
+      double val = var1.value(rv_mgr.matrix());
       if ( val > 0.0 ) {
 	var_list.push_back(var1);
       }
@@ -230,7 +233,7 @@ igugen(int argc,
       }
 
       vector<ymuint> block_map;
-      bool stat = pt.cf_partition(vect_list, sigfunc_list, block_map);
+      bool stat = pt.cf_partition(vect_list, rv_mgr.matrix(), sigfunc_list, block_map);
       if ( stat ) {
 	found = true;
 #if 0
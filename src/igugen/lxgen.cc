@@ -42,10 +42,42 @@ lxgen(int argc,
   PoptNone popt_r("rnd_lx", 'r', "random linear transformation");
   main_app.add_option(&popt_r);
 
+  // method オプション
+  PoptStr popt_method("method", 0, "specify the generation method", "<METHOD-STR>");
+  main_app.add_option(&popt_method);
+
   // s オプション
   PoptInt popt_s("n_sample", 's', "specify the number of samples", "<INT>");
   main_app.add_option(&popt_s);
 
+  // t オプション
+  PoptUint popt_t("thread_num", 't',
+		  "specify the number of threads (0: all cores)", "<INT>");
+  main_app.add_option(&popt_t);
+
+  // chains オプション
+  PoptUint popt_chains("chains", 0,
+		       "specify the number of independent chains", "<INT>");
+  main_app.add_option(&popt_chains);
+
+  // seed オプション
+  PoptUint popt_seed("seed", 0,
+		     "specify the random seed", "<INT>");
+  main_app.add_option(&popt_seed);
+
+  // time_limit オプション
+  PoptUint popt_time("time_limit", 0,
+		     "specify the time limit in seconds", "<INT>");
+  main_app.add_option(&popt_time);
+
+  // progress オプション
+  PoptNone popt_progress("progress", 0, "print progress");
+  main_app.add_option(&popt_progress);
+
+  // hash-stats オプション
+  PoptNone popt_hash("hash-stats", 0, "print statistics of duplicate check");
+  main_app.add_option(&popt_hash);
+
   main_app.set_other_option_help("<filename>");
 
   tPoptStat stat = main_app.parse_options(argc, argv, 0);
@@ -53,8 +85,9 @@ lxgen(int argc,
     return 1;
   }
 
-  if ( !popt_l.is_specified() && !popt_r.is_specified() ) {
-    cerr << "Either 'l' or 'r' must be specified." << endl;
+  if ( !popt_l.is_specified() && !popt_r.is_specified() &&
+       !popt_method.is_specified() ) {
+    cerr << "One of 'l', 'r' or '--method' must be specified." << endl;
     return 1;
   }
 
@@ -66,13 +99,12 @@ lxgen(int argc,
 
   RvMgr rv_mgr;
 
-  ifstream ifs(args[0]);
-  if ( !ifs ) {
-    cerr << "Could not open " << args[0] << endl;
-    return 1;
-  }
-
-  if ( !rv_mgr.read_data(ifs) ) {
+  // 拡張子が .rvb のファイルはバイナリ形式としてマップする．
+  const string& filename = args[0];
+  bool rvb = filename.size() > 4 &&
+    filename.compare(filename.size() - 4, 4, ".rvb") == 0;
+  bool stat = rvb ? rv_mgr.map_binary(filename) : rv_mgr.read_data(filename);
+  if ( !stat ) {
     cerr << "Error in reading " << args[0] << endl;
     return 1;
   }
@@ -80,6 +112,9 @@ lxgen(int argc,
   cout << "# of inputs:     " << rv_mgr.vect_size() << endl
        << "# of vectors:    " << rv_mgr.vect_list().size() << endl
        << "# of index bits: " << rv_mgr.index_size() << endl;
+  if ( popt_hash.is_specified() ) {
+    rv_mgr.print_hash_stats(cout);
+  }
 
   vector<Variable> var_list;
 
@@ -88,13 +123,54 @@ lxgen(int argc,
     n_sample = popt_s.val();
   }
   LxGen* lxgen = nullptr;
-  if ( popt_l.is_specified() ) {
+  if ( popt_method.is_specified() ) {
+    lxgen = LxGen::new_obj(popt_method.val());
+    if ( lxgen == nullptr ) {
+      return 1;
+    }
+  }
+  else if ( popt_l.is_specified() ) {
     lxgen = LxGen::new_obj("MCMC");
   }
   else if ( popt_r.is_specified() ) {
     lxgen = LxGen::new_obj("Greedy");
   }
+  if ( popt_t.is_specified() ) {
+    lxgen->set_thread_num(popt_t.val());
+  }
+  if ( popt_chains.is_specified() ) {
+    if ( popt_chains.val() == 0 ) {
+      cerr << "--chains must be positive." << endl;
+      return 1;
+    }
+    lxgen->set_chain_num(popt_chains.val());
+  }
+  if ( popt_seed.is_specified() ) {
+    lxgen->set_seed(popt_seed.val());
+  }
+  if ( popt_time.is_specified() ) {
+    lxgen->set_time_limit(popt_time.val());
+  }
+  if ( popt_progress.is_specified() ) {
+    lxgen->set_observer([](const LxGenStats& stats) {
+	cerr << setw(8) << stats.mTime << "s "
+	     << setw(12) << stats.mStepNum << " steps "
+	     << setw(12) << stats.mStepRate << " steps/s "
+	     << "best = " << stats.mBestValue;
+	if ( stats.mFullRank > 0 ) {
+	  cerr << " rank = " << stats.mRank << "/" << stats.mFullRank;
+	}
+	if ( stats.mInterrupted ) {
+	  cerr << " (interrupted)";
+	}
+	cerr << endl;
+      });
+  }
   lxgen->generate(rv_mgr.vect_list(), n_sample, var_list);
+  if ( lxgen->full_rank() > 0 ) {
+    cout << "rank:            " << lxgen->rank()
+	 << " / " << lxgen->full_rank() << endl;
+  }
 
   // 度数分布を求める．
   ymuint h_array[20];
@@ -103,7 +179,7 @@ lxgen(int argc,
   }
   for (ymuint i = 0; i < var_list.size(); ++ i) {
     const Variable& var = var_list[i];
-    double v = var.value(rv_mgr.vect_list());
+    double v = var.value(rv_mgr.matrix());
     ymuint pos = static_cast<ymuint>(v * 20);
     ++ h_array[pos];
   }
@@ -10,7 +10,6 @@
 #include "RandHashGen.h"
 #include "Variable.h"
 #include "SigFunc.h"
-#include "ym/RandCombiGen.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -29,6 +28,14 @@ RandHashGen::~RandHashGen()
 {
 }
 
+// @brief 乱数の系列を設定する．
+// @param[in] rs 乱数の系列
+void
+RandHashGen::set_rand_stream(const RandStream& rs)
+{
+  mRandStream = rs;
+}
+
 // @brief ランダムにハッシュ関数を作る．
 // @param[in] input_num 入力数
 // @param[in] output_num 出力数
@@ -40,16 +47,16 @@ RandHashGen::gen_func(ymuint input_num,
 {
   vector<Variable> var_list(output_num);
 
-  RandCombiGen rcg1(input_num, output_num);
-  rcg1.generate(mRandGen);
+  vector<ymuint> elem_list1;
+  mRandStream.combination(input_num, output_num, elem_list1);
 
   for (ymuint opos = 0; opos < output_num; ++ opos) {
-    ymuint pos0 = rcg1.elem(opos);
+    ymuint pos0 = elem_list1[opos];
     Variable var1(input_num, pos0);
 
     if ( max_degree > 1 ) {
       ymuint mask = (1U << (max_degree - 1)) - 1;
-      ymuint bit_pat = mRandGen.int32() % mask;
+      ymuint bit_pat = mRandStream.int32() % mask;
       ymuint nbit = 0;
       for (ymuint k = 0; k < max_degree; ++ k) {
 	if ( bit_pat & (1U << k) ) {
@@ -57,7 +64,6 @@ RandHashGen::gen_func(ymuint input_num,
 	}
       }
       if ( nbit > 0 ) {
-	RandCombiGen rcg2(input_num - 1, nbit);
 	vector<ymuint> pos_list;
 	pos_list.reserve(input_num - 1);
 	for (ymuint k = 0; k < input_num; ++ k) {
@@ -65,9 +71,10 @@ RandHashGen::gen_func(ymuint input_num,
 	    pos_list.push_back(k);
 	  }
 	}
-	rcg2.generate(mRandGen);
+	vector<ymuint> elem_list2;
+	mRandStream.combination(input_num - 1, nbit, elem_list2);
 	for (ymuint k = 0; k < nbit; ++ k) {
-	  ymuint pos = pos_list[rcg2.elem(k)];
+	  ymuint pos = pos_list[elem_list2[k]];
 	  Variable var2(input_num, pos);
 	  var1 *= var2;
 	}
@@ -22,13 +22,21 @@ BEGIN_NAMESPACE_YM_IGF
 // @brief コンストラクタ
 RandSigFuncGen::RandSigFuncGen()
 {
-  mRcg = nullptr;
+  mGenCount = 0;
 }
 
 // @brief デストラクタ
 RandSigFuncGen::~RandSigFuncGen()
 {
-  delete mRcg;
+}
+
+// @brief 乱数の系列を設定する．
+// @param[in] rs 乱数の系列
+void
+RandSigFuncGen::set_rand_stream(const RandStream& rs)
+{
+  mRandStream = rs;
+  mGenCount = 0;
 }
 
 // @brief 初期化を行う．
@@ -42,26 +50,31 @@ RandSigFuncGen::init(const vector<const RegVect*>& rv_list,
 		     ymuint width,
 		     ymuint m)
 {
-  mVarList = var_list;
+  mVarTable.clear();
+  mIdList.resize(var_list.size());
+  for (ymuint i = 0; i < var_list.size(); ++ i) {
+    mIdList[i] = mVarTable.intern(var_list[i]);
+  }
   mWidth = width;
   mM = m;
-
-  delete mRcg;
-  mRcg = new RandCombiGen(var_list.size(), width);
 }
 
 // @brief signature function を一つ生成する．
 vector<const SigFunc*>
 RandSigFuncGen::generate()
 {
+  RandStream rg = mRandStream.split(mGenCount);
+  ++ mGenCount;
+  ymuint nv = mIdList.size();
   vector<const SigFunc*> ans(mM);
+  vector<ymuint> elem_list;
   for (ymuint i = 0; i < mM; ++ i) {
-    mRcg->generate(mRgChoose);
-    vector<Variable> tmp_list(mWidth);
+    rg.combination(nv, mWidth, elem_list);
+    vector<ymuint> tmp_list(mWidth);
     for (ymuint j = 0; j < mWidth; ++ j) {
-      tmp_list[j] = mVarList[mRcg->elem(j)];
+      tmp_list[j] = mIdList[elem_list[j]];
     }
-    ans[i] = new SigFunc(tmp_list);
+    ans[i] = new SigFunc(mVarTable, tmp_list);
   }
   return ans;
 }
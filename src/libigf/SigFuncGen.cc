@@ -71,6 +71,14 @@ SigFuncGen::~SigFuncGen()
 {
 }
 
+// @brief 乱数の系列を設定する．
+// @param[in] rs 乱数の系列
+void
+SigFuncGen::set_rand_stream(const RandStream& rs)
+{
+  mRandStream = rs;
+}
+
 // @brief 初期化を行う．
 // @param[in] rv_list 登録ベクタのリスト
 // @param[in] var_list 変数のリスト
@@ -90,6 +98,9 @@ SigFuncGen::init(const vector<const RegVect*>& rv_list,
   mM = m;
   mSampleInt = sample_int;
 
+  mRgChoose = mRandStream.split(0);
+  mRgAccept = mRandStream.split(1);
+
   mCurStateArray.clear();
   mCurStateArray.resize(mM);
   for (ymuint i = 0; i < mM; ++ i) {
@@ -140,7 +151,7 @@ void
 SigFuncGen::FuncState::init(const vector<const RegVect*>& rv_list,
 			    const vector<Variable>& var_list,
 			    ymuint width,
-			    RandGen& rg1)
+			    RandStream& rg1)
 {
   // 候補リストを作る．
 #if 0
@@ -183,8 +194,8 @@ SigFuncGen::FuncState::init(const vector<const RegVect*>& rv_list,
 // @param[in] rv_list 登録ベクタのリスト
 void
 SigFuncGen::FuncState::next_move(const vector<const RegVect*>& rv_list,
-				 RandGen& rg1,
-				 RandGen& rg2)
+				 RandStream& rg1,
+				 RandStream& rg2)
 {
   vector<Variable> new_state = mCurState;
   // 変更する位置を選ぶ．
@@ -205,7 +216,7 @@ SigFuncGen::FuncState::next_move(const vector<const RegVect*>& rv_list,
   }
   // ここに来たということは受容された．
   mCandList.push_back(old_var);
-  mCurState = new_state;
+  mCurState.swap(new_state);
   mCurVal = new_val;
 }
 
@@ -217,11 +228,11 @@ SigFuncGen::FuncState::new_func() const
 }
 
 // @brief 変数をランダムに選ぶ．
-// @param[in] rg 乱数発生器
+// @param[in] rg 乱数の系列
 //
 // 重複を避けるために選ばれた変数は mCandList から取り除かれる．
 Variable
-SigFuncGen::FuncState::choose_var(RandGen& rg)
+SigFuncGen::FuncState::choose_var(RandStream& rg)
 {
   ymuint n = mCandList.size();
   ymuint pos = rg.int32() % n;
@@ -0,0 +1,105 @@
+
+/// @file Anneal_LxGen.cc
+/// @brief Anneal_LxGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Anneal_LxGen.h"
+#include "VarPool.h"
+#include <cmath>
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス Anneal_LxGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+//
+// 価値は 0.0 から 1.0 の範囲なので，
+// 開始温度では 0.1 程度の悪化をそこそこ受け入れ，
+// 終了温度ではほとんど受け入れないようにしておく．
+Anneal_LxGen::Anneal_LxGen() :
+  mSchedule(kGeometric),
+  mStartTemp(0.1),
+  mEndTemp(1.0e-4)
+{
+}
+
+// @brief デストラクタ
+Anneal_LxGen::~Anneal_LxGen()
+{
+}
+
+// @brief 冷却スケジュールを設定する．
+// @param[in] schedule スケジュールの種類
+void
+Anneal_LxGen::set_schedule(Schedule schedule)
+{
+  mSchedule = schedule;
+}
+
+// @brief 温度の範囲を設定する．
+// @param[in] start_temp 開始温度
+// @param[in] end_temp 終了温度 ( 0.0 < end_temp <= start_temp )
+void
+Anneal_LxGen::set_temperature(double start_temp,
+			      double end_temp)
+{
+  ASSERT_COND( end_temp > 0.0 && end_temp <= start_temp );
+  mStartTemp = start_temp;
+  mEndTemp = end_temp;
+}
+
+// @brief i 番目の遷移での温度を返す．
+// @param[in] i 遷移の番号 ( 0 <= i < step_num )
+// @param[in] step_num 遷移の総数
+double
+Anneal_LxGen::temperature(ymuint i,
+			  ymuint step_num) const
+{
+  if ( step_num <= 1 ) {
+    return mStartTemp;
+  }
+  double x = static_cast<double>(i) / static_cast<double>(step_num - 1);
+  switch ( mSchedule ) {
+  case kGeometric:
+    return mStartTemp * pow(mEndTemp / mStartTemp, x);
+
+  case kLinear:
+    return mStartTemp + (mEndTemp - mStartTemp) * x;
+
+  case kLogarithmic:
+    break;
+  }
+  double t = mStartTemp / (1.0 + log(1.0 + i));
+  return t > mEndTemp ? t : mEndTemp;
+}
+
+// @brief 連鎖を動かす．
+// @param[in] cid 連鎖番号
+// @param[in] step_num 遷移の回数
+// @param[out] var_pool 訪れた状態を格納するプール
+void
+Anneal_LxGen::run_chain(ymuint cid,
+			ymuint step_num,
+			VarPool& var_pool)
+{
+  Chain chain;
+  init_chain(cid, chain);
+  var_pool.put(chain.mCurState, chain.mCurVal);
+  for (ymuint i = 0; i < step_num; ++ i) {
+    metropolis_move(chain, temperature(i, step_num));
+    var_pool.put(chain.mCurState, chain.mCurVal);
+    if ( !count_step(chain) ) {
+      break;
+    }
+  }
+  flush_step(chain);
+}
+
+END_NAMESPACE_IGF
@@ -0,0 +1,107 @@
+#ifndef ANNEAL_LXGEN_H
+#define ANNEAL_LXGEN_H
+
+/// @file Anneal_LxGen.h
+/// @brief Anneal_LxGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "MCMC_LxGen.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class Anneal_LxGen Anneal_LxGen.h "Anneal_LxGen.h"
+/// @brief 焼きなまし法で合成変数を生成するクラス
+///
+/// 遷移は MCMC_LxGen と同じだが，受容判定に温度を用いる．
+/// 温度は連鎖ごとに開始温度から終了温度まで下げていく．
+/// 連鎖(chain_num() 個)ごとに独立な焼きなましを並列に行う．
+//////////////////////////////////////////////////////////////////////
+class Anneal_LxGen :
+  public MCMC_LxGen
+{
+public:
+
+  /// @brief 冷却スケジュールの種類
+  enum Schedule {
+    /// @brief 等比的に下げる．
+    kGeometric,
+    /// @brief 線形に下げる．
+    kLinear,
+    /// @brief T0 / (1 + log(1 + i)) で下げる(終了温度で打ち切る)．
+    kLogarithmic
+  };
+
+  /// @brief コンストラクタ
+  Anneal_LxGen();
+
+  /// @brief デストラクタ
+  virtual
+  ~Anneal_LxGen();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 冷却スケジュールを設定する．
+  /// @param[in] schedule スケジュールの種類
+  void
+  set_schedule(Schedule schedule);
+
+  /// @brief 温度の範囲を設定する．
+  /// @param[in] start_temp 開始温度
+  /// @param[in] end_temp 終了温度 ( 0.0 < end_temp <= start_temp )
+  void
+  set_temperature(double start_temp,
+		  double end_temp);
+
+  /// @brief i 番目の遷移での温度を返す．
+  /// @param[in] i 遷移の番号 ( 0 <= i < step_num )
+  /// @param[in] step_num 遷移の総数
+  double
+  temperature(ymuint i,
+	      ymuint step_num) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 連鎖を動かす．
+  /// @param[in] cid 連鎖番号
+  /// @param[in] step_num 遷移の回数
+  /// @param[out] var_pool 訪れた状態を格納するプール
+  virtual
+  void
+  run_chain(ymuint cid,
+	    ymuint step_num,
+	    VarPool& var_pool);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 冷却スケジュール
+  Schedule mSchedule;
+
+  // 開始温度
+  double mStartTemp;
+
+  // 終了温度
+  double mEndTemp;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // ANNEAL_LXGEN_H
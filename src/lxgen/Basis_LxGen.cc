@@ -0,0 +1,130 @@
+
+/// @file Basis_LxGen.cc
+/// @brief Basis_LxGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Basis_LxGen.h"
+#include "RvMatrix.h"
+#include "Variable.h"
+#include "ClassBits.h"
+#include "CombGen.h"
+#include "VarBasis.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス Basis_LxGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Basis_LxGen::Basis_LxGen() :
+  mCandFactor(8)
+{
+}
+
+// @brief デストラクタ
+Basis_LxGen::~Basis_LxGen()
+{
+}
+
+// @brief 合成変数の生成を行う．
+// @param[in] rv_list 登録ベクタのリスト
+// @param[in] req_num 生成する変数の数
+// @param[out] var_list 結果の変数を入れるリスト
+void
+Basis_LxGen::generate(const vector<const RegVect*>& rv_list,
+		      ymuint req_num,
+		      vector<Variable>& var_list)
+{
+  start_budget();
+
+  // 初期変数集合を作る．
+  // プライマリ変数は互いに異なる単位ベクトルなので線形独立となる．
+  RvMatrix rv_mat(rv_list);
+  vector<Variable> pvar_list;
+  get_primary_vars(rv_mat, pvar_list);
+  ymuint np = pvar_list.size();
+  set_rank(0, np);
+
+  var_list.clear();
+  if ( np == 0 || req_num == 0 ) {
+    finish_budget();
+    return;
+  }
+
+  // 候補を作る．
+  vector<Variable> cand_list;
+  vector<double> val_list;
+  CombGen comb_gen(rv_mat, pvar_list);
+  RandStream rg = rand_stream();
+  ymuint prev_num = 0;
+  double best_val = 0.0;
+  comb_gen.generate(rg, req_num * mCandFactor, cand_list, val_list, [&](ymuint num) {
+      for (ymuint i = prev_num; i < num; ++ i) {
+	if ( best_val < val_list[i] ) {
+	  best_val = val_list[i];
+	}
+      }
+      bool cont = consume(num - prev_num, best_val);
+      prev_num = num;
+      return cont;
+    });
+  // ランダムな候補だけでは全体を張らないことがあるので
+  // プライマリ変数も候補に加える．
+  ymuint64 nv = rv_mat.vect_num();
+  for (ymuint i = 0; i < np; ++ i) {
+    const Variable& var = pvar_list[i];
+    ClassBits bits(rv_mat, var);
+    ymuint64 n1 = bits.count1();
+    cand_list.push_back(var);
+    val_list.push_back(Variable::calc_value(nv - n1, n1));
+  }
+
+  // 価値の高い順に並べる．
+  // 同じ価値の候補は作った順とするので結果はシードのみで決まる．
+  ymuint nc = cand_list.size();
+  vector<ymuint> order(nc);
+  for (ymuint i = 0; i < nc; ++ i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](ymuint a, ymuint b) {
+      return val_list[a] > val_list[b];
+    });
+
+  // 線形独立なものを選んでいく．
+  best_val = val_list[order[0]];
+  ymuint target = req_num < np ? req_num : np;
+  const ymuint kCheckInterval = 256;
+  VarBasis basis(rv_mat.vect_size());
+  var_list.reserve(target);
+  for (ymuint k = 0; k < nc && basis.rank() < target; ++ k) {
+    ymuint i = order[k];
+    if ( basis.add(cand_list[i]) ) {
+      var_list.push_back(cand_list[i]);
+    }
+    if ( (k + 1) % kCheckInterval == 0 ) {
+      set_rank(basis.rank(), np);
+      if ( !consume(kCheckInterval, best_val) ) {
+	break;
+      }
+    }
+  }
+  set_rank(basis.rank(), np);
+  finish_budget();
+}
+
+// @brief 候補の数を設定する．
+// @param[in] factor 生成する変数の数に対する倍率
+void
+Basis_LxGen::set_candidate_factor(ymuint factor)
+{
+  mCandFactor = factor;
+}
+
+END_NAMESPACE_IGF
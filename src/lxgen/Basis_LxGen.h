@@ -0,0 +1,81 @@
+#ifndef BASIS_LXGEN_H
+#define BASIS_LXGEN_H
+
+/// @file Basis_LxGen.h
+/// @brief Basis_LxGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LxGenBase.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class Basis_LxGen Basis_LxGen.h "Basis_LxGen.h"
+/// @brief 線形独立な合成変数を生成するクラス
+///
+/// プライマリ変数と，そのランダムな線形結合(CombGen で作る)を候補とし，
+/// 価値の高い順に今までに選んだ変数と線形独立なものを選んでいく．
+/// 線形独立な集合はマトロイドをなすので，こうして選んだ集合は
+/// 候補の中で価値の和が最大の線形独立な集合となる．
+/// 独立性の判定は VarBasis で行う．
+///
+/// 結果の変数は常に線形独立なので，その数が階数となる．
+/// プライマリ変数の数(全体の階数)より多くは作れない．
+/// 結果の階数とプライマリ変数の階数は rank() と full_rank()
+/// および LxGenStats で得られる．
+//////////////////////////////////////////////////////////////////////
+class Basis_LxGen :
+  public LxGenBase
+{
+public:
+
+  /// @brief コンストラクタ
+  Basis_LxGen();
+
+  /// @brief デストラクタ
+  virtual
+  ~Basis_LxGen();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 合成変数の生成を行う．
+  /// @param[in] rv_list 登録ベクタのリスト
+  /// @param[in] req_num 生成する変数の数
+  /// @param[out] var_list 生成された変数を格納するリスト
+  virtual
+  void
+  generate(const vector<const RegVect*>& rv_list,
+	   ymuint req_num,
+	   vector<Variable>& var_list);
+
+  /// @brief 候補の数を設定する．
+  /// @param[in] factor 生成する変数の数に対する倍率
+  ///
+  /// ランダムな線形結合を req_num * factor 個作る．
+  /// デフォルトは 8
+  void
+  set_candidate_factor(ymuint factor);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 候補の数の倍率
+  ymuint mCandFactor;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // BASIS_LXGEN_H
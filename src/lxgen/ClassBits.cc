@@ -0,0 +1,63 @@
+
+/// @file ClassBits.cc
+/// @brief ClassBits の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ClassBits.h"
+#include "Variable.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス ClassBits
+//////////////////////////////////////////////////////////////////////
+
+// @brief 空のコンストラクタ
+ClassBits::ClassBits()
+{
+}
+
+// @brief 変数を指定したコンストラクタ
+// @param[in] rv_mat 登録ベクタの行列
+// @param[in] var 変数
+ClassBits::ClassBits(const RvMatrix& rv_mat,
+		     const Variable& var)
+{
+  set(rv_mat, var);
+}
+
+// @brief デストラクタ
+ClassBits::~ClassBits()
+{
+}
+
+// @brief 変数の分類結果を設定する．
+// @param[in] rv_mat 登録ベクタの行列
+// @param[in] var 変数
+void
+ClassBits::set(const RvMatrix& rv_mat,
+	       const Variable& var)
+{
+  mBits.resize(rv_mat.column_size());
+  if ( !mBits.empty() ) {
+    rv_mat.classify_all(var, &mBits[0]);
+  }
+}
+
+// @brief プライマリ変数の分類結果を設定する．
+// @param[in] rv_mat 登録ベクタの行列
+// @param[in] vid 変数番号
+void
+ClassBits::set_primary(const RvMatrix& rv_mat,
+		       ymuint vid)
+{
+  const ymuint64* col = rv_mat.column(vid);
+  mBits.assign(col, col + rv_mat.column_size());
+}
+
+END_NAMESPACE_IGF
@@ -0,0 +1,180 @@
+#ifndef CLASSBITS_H
+#define CLASSBITS_H
+
+/// @file ClassBits.h
+/// @brief ClassBits のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+#include "RvMatrix.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class ClassBits ClassBits.h "ClassBits.h"
+/// @brief 変数による登録ベクタの分類結果を保持するクラス
+///
+/// RvMatrix::classify_all() の結果(ベクタ数ビットのビットベクタ)
+/// をキャッシュしておくためのもの．
+/// 合成変数の分類結果は元の変数の分類結果の XOR となるので，
+/// 変数を合成するたびに全ベクタを分類しなおす必要はない．
+//////////////////////////////////////////////////////////////////////
+class ClassBits
+{
+public:
+
+  /// @brief 空のコンストラクタ
+  ClassBits();
+
+  /// @brief 変数を指定したコンストラクタ
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[in] var 変数
+  ClassBits(const RvMatrix& rv_mat,
+	    const Variable& var);
+
+  /// @brief デストラクタ
+  ~ClassBits();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数の分類結果を設定する．
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[in] var 変数
+  void
+  set(const RvMatrix& rv_mat,
+      const Variable& var);
+
+  /// @brief プライマリ変数の分類結果を設定する．
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[in] vid 変数番号
+  ///
+  /// 結果は rv_mat の vid 番目の列そのものとなる．
+  void
+  set_primary(const RvMatrix& rv_mat,
+	      ymuint vid);
+
+  /// @brief 1 に分類されたベクタ数を返す．
+  ymuint64
+  count1() const;
+
+  /// @brief 変数を合成した結果の分類結果を求める．
+  /// @param[in] right 合成する変数の分類結果
+  /// @param[out] dst 結果を格納するオブジェクト
+  /// @return dst の count1() の値
+  ///
+  /// dst は自分自身でもよい．
+  ymuint64
+  compose(const ClassBits& right,
+	  ClassBits& dst) const;
+
+  /// @brief 合成演算
+  /// @param[in] right 合成する変数の分類結果
+  /// @return count1() の値
+  ymuint64
+  operator*=(const ClassBits& right);
+
+  /// @brief 内容を交換する．
+  /// @param[in] right 交換相手
+  void
+  swap(ClassBits& right);
+
+  /// @brief ブロック数を返す．
+  ymuint
+  block_size() const;
+
+  /// @brief ブロックの先頭を返す．
+  const ymuint64*
+  data() const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 分類結果を表すビットベクタ
+  vector<ymuint64> mBits;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 1 に分類されたベクタ数を返す．
+inline
+ymuint64
+ClassBits::count1() const
+{
+  if ( mBits.empty() ) {
+    return 0;
+  }
+  return RvMatrix::count_bits(&mBits[0], mBits.size());
+}
+
+// @brief 変数を合成した結果の分類結果を求める．
+// @param[in] right 合成する変数の分類結果
+// @param[out] dst 結果を格納するオブジェクト
+// @return dst の count1() の値
+inline
+ymuint64
+ClassBits::compose(const ClassBits& right,
+		   ClassBits& dst) const
+{
+  ASSERT_COND( mBits.size() == right.mBits.size() );
+  ymuint n = mBits.size();
+  dst.mBits.resize(n);
+  if ( n == 0 ) {
+    return 0;
+  }
+  return RvMatrix::xor_bits(&mBits[0], &right.mBits[0], &dst.mBits[0], n);
+}
+
+// @brief 合成演算
+// @param[in] right 合成する変数の分類結果
+// @return count1() の値
+inline
+ymuint64
+ClassBits::operator*=(const ClassBits& right)
+{
+  return compose(right, *this);
+}
+
+// @brief 内容を交換する．
+// @param[in] right 交換相手
+inline
+void
+ClassBits::swap(ClassBits& right)
+{
+  mBits.swap(right.mBits);
+}
+
+// @brief ブロック数を返す．
+inline
+ymuint
+ClassBits::block_size() const
+{
+  return mBits.size();
+}
+
+// @brief ブロックの先頭を返す．
+inline
+const ymuint64*
+ClassBits::data() const
+{
+  return mBits.empty() ? nullptr : &mBits[0];
+}
+
+END_NAMESPACE_IGF
+
+#endif // CLASSBITS_H
@@ -0,0 +1,127 @@
+
+/// @file ClassCounter.cc
+/// @brief ClassCounter の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "ClassCounter.h"
+#include "ClassBits.h"
+#include "RvMatrix.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス ClassCounter
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] block_size ブロック数
+ClassCounter::ClassCounter(ymuint block_size)
+{
+  clear(block_size);
+}
+
+// @brief デストラクタ
+ClassCounter::~ClassCounter()
+{
+}
+
+// @brief 内容を空にする．
+// @param[in] block_size ブロック数
+void
+ClassCounter::clear(ymuint block_size)
+{
+  mBlockSize = block_size;
+  mNum = 0;
+  mPlanes.clear();
+  mPlaneNum = 0;
+}
+
+// @brief 分類結果を加える．
+// @param[in] bits 分類結果
+void
+ClassCounter::add(const ClassBits& bits)
+{
+  ASSERT_COND( bits.block_size() == mBlockSize );
+
+  ++ mNum;
+  // mNum を表せるだけの桁数を確保しておけば桁あふれは起きない．
+  if ( (mNum >> mPlaneNum) != 0 ) {
+    ++ mPlaneNum;
+    mPlanes.resize(mPlaneNum * mBlockSize, 0ULL);
+  }
+
+  const ymuint64* src = bits.data();
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    // 下の桁から順に桁上げを伝搬させる．
+    ymuint64 carry = src[i];
+    for (ymuint b = 0; carry != 0ULL; ++ b) {
+      ASSERT_COND( b < mPlaneNum );
+      ymuint64& p = mPlanes[b * mBlockSize + i];
+      ymuint64 c1 = p & carry;
+      p ^= carry;
+      carry = c1;
+    }
+  }
+}
+
+// @brief 分類結果を取り除く．
+// @param[in] bits 分類結果
+void
+ClassCounter::sub(const ClassBits& bits)
+{
+  ASSERT_COND( bits.block_size() == mBlockSize );
+  ASSERT_COND( mNum > 0 );
+
+  -- mNum;
+  const ymuint64* src = bits.data();
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    // 下の桁から順に桁借りを伝搬させる．
+    ymuint64 borrow = src[i];
+    for (ymuint b = 0; borrow != 0ULL; ++ b) {
+      ASSERT_COND( b < mPlaneNum );
+      ymuint64& p = mPlanes[b * mBlockSize + i];
+      ymuint64 b1 = ~p & borrow;
+      p ^= borrow;
+      borrow = b1;
+    }
+  }
+}
+
+// @brief Σ c[v] を返す．
+ymuint64
+ClassCounter::total() const
+{
+  ymuint64 n = 0;
+  for (ymuint b = 0; b < mPlaneNum; ++ b) {
+    ymuint64 n1 = RvMatrix::count_bits(&mPlanes[b * mBlockSize], mBlockSize);
+    n += n1 << b;
+  }
+  return n;
+}
+
+// @brief Σ bits[v] * c[v] を返す．
+// @param[in] bits 分類結果
+ymuint64
+ClassCounter::count_and(const ClassBits& bits) const
+{
+  ASSERT_COND( bits.block_size() == mBlockSize );
+
+  const ymuint64* src = bits.data();
+  ymuint64 n = 0;
+  for (ymuint b = 0; b < mPlaneNum; ++ b) {
+    const ymuint64* plane = &mPlanes[b * mBlockSize];
+    ymuint64 n1 = 0;
+    for (ymuint i = 0; i < mBlockSize; ++ i) {
+      n1 += RvMatrix::popcount(plane[i] & src[i]);
+    }
+    n += n1 << b;
+  }
+  return n;
+}
+
+END_NAMESPACE_IGF
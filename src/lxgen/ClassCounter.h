@@ -0,0 +1,113 @@
+#ifndef CLASSCOUNTER_H
+#define CLASSCOUNTER_H
+
+/// @file ClassCounter.h
+/// @brief ClassCounter のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+class ClassBits;
+
+//////////////////////////////////////////////////////////////////////
+/// @class ClassCounter ClassCounter.h "ClassCounter.h"
+/// @brief 変数集合による分類結果をベクタごとに数えるクラス
+///
+/// 登録ベクタごとに，集合中の変数のうちそのベクタを 1 に分類したものの数
+/// c[v] を保持する．
+/// c[v] はビットスライス形式(各ビット桁ごとのビットベクタ)で持つので，
+/// 追加と削除はビットベクタの加減算，
+/// 分類結果 b との積和 Σ b[v] * c[v] は桁数回の AND と popcount で求まる．
+//////////////////////////////////////////////////////////////////////
+class ClassCounter
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] block_size ブロック数
+  explicit
+  ClassCounter(ymuint block_size = 0);
+
+  /// @brief デストラクタ
+  ~ClassCounter();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容を空にする．
+  /// @param[in] block_size ブロック数
+  void
+  clear(ymuint block_size);
+
+  /// @brief 登録されている分類結果の数を返す．
+  ymuint
+  num() const;
+
+  /// @brief 分類結果を加える．
+  /// @param[in] bits 分類結果
+  void
+  add(const ClassBits& bits);
+
+  /// @brief 分類結果を取り除く．
+  /// @param[in] bits 分類結果
+  ///
+  /// bits は add() 済みのものでなければならない．
+  void
+  sub(const ClassBits& bits);
+
+  /// @brief Σ c[v] を返す．
+  ymuint64
+  total() const;
+
+  /// @brief Σ bits[v] * c[v] を返す．
+  /// @param[in] bits 分類結果
+  ymuint64
+  count_and(const ClassBits& bits) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ブロック数
+  ymuint mBlockSize;
+
+  // 登録されている分類結果の数
+  ymuint mNum;
+
+  // 桁ごとのビットベクタ
+  // 桁 b のブロック i は mPlanes[b * mBlockSize + i]
+  vector<ymuint64> mPlanes;
+
+  // 桁数
+  ymuint mPlaneNum;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 登録されている分類結果の数を返す．
+inline
+ymuint
+ClassCounter::num() const
+{
+  return mNum;
+}
+
+END_NAMESPACE_IGF
+
+#endif // CLASSCOUNTER_H
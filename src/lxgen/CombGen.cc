@@ -0,0 +1,234 @@
+
+/// @file CombGen.cc
+/// @brief CombGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "CombGen.h"
+#include "ClassBits.h"
+#include "RvMatrix.h"
+#include "Variable.h"
+#include <algorithm>
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 一度に積を求める行数
+const ymuint kBatchSize = 1024;
+
+// 表を作る列方向のブロック数
+// 表の大きさは 256 * kChunkSize ブロックとなる．
+const ymuint kChunkSize = 128;
+
+// 係数行のハッシュ値を求める．
+inline
+ymuint64
+coef_hash(const ymuint64* row,
+	  ymuint nblk)
+{
+  ymuint64 h = 0x9E3779B97F4A7C15ULL;
+  for (ymuint i = 0; i < nblk; ++ i) {
+    h ^= row[i];
+    h ^= (h >> 30);
+    h *= 0xBF58476D1CE4E5B9ULL;
+    h ^= (h >> 27);
+    h *= 0x94D049BB133111EBULL;
+    h ^= (h >> 31);
+  }
+  return h;
+}
+
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス CombGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] rv_mat 登録ベクタの行列
+// @param[in] pvar_list プライマリ変数のリスト
+CombGen::CombGen(const RvMatrix& rv_mat,
+		 const vector<Variable>& pvar_list) :
+  mVectNum(rv_mat.vect_num()),
+  mVarSize(rv_mat.vect_size()),
+  mPrimNum(pvar_list.size())
+{
+  mCoefSize = (mPrimNum + 63) / 64;
+  mVarBlock = (mVarSize + 63) / 64;
+  mRowSize = mVarBlock + rv_mat.column_size();
+
+  ymuint nrow = (mPrimNum + 7) / 8 * 8;
+  mBody.assign(static_cast<ymuint64>(nrow) * mRowSize, 0ULL);
+  ClassBits bits;
+  for (ymuint p = 0; p < mPrimNum; ++ p) {
+    const Variable& var = pvar_list[p];
+    ymuint64* row = &mBody[static_cast<ymuint64>(p) * mRowSize];
+    for (ymuint i = 0; i < mVarBlock; ++ i) {
+      row[i] = var.raw_data(i);
+    }
+    bits.set(rv_mat, var);
+    for (ymuint i = 0; i < bits.block_size(); ++ i) {
+      row[mVarBlock + i] = bits.data()[i];
+    }
+  }
+}
+
+// @brief デストラクタ
+CombGen::~CombGen()
+{
+}
+
+// @brief ランダムな合成変数を作る．
+// @param[in] rg 係数を選ぶための乱数の系列
+// @param[in] num 作る変数の数
+// @param[out] var_list 合成変数のリスト
+// @param[out] val_list 価値のリスト(var_list と同じ順)
+// @param[in] progress 途中経過を受け取る関数
+void
+CombGen::generate(RandStream& rg,
+		  ymuint num,
+		  vector<Variable>& var_list,
+		  vector<double>& val_list,
+		  const std::function<bool (ymuint)>& progress)
+{
+  var_list.clear();
+  val_list.clear();
+  if ( mPrimNum == 0 ) {
+    return;
+  }
+  if ( mPrimNum < 32 ) {
+    ymuint max_num = (1U << mPrimNum) - 1;
+    if ( num > max_num ) {
+      num = max_num;
+    }
+  }
+  var_list.reserve(num);
+  val_list.reserve(num);
+
+  // 係数行列を作る．
+  // 0 の行と重複した行は選びなおす．
+  // 重複のチェックは係数行列の行番号を要素とする
+  // 線形探索のオープンアドレス法のハッシュ表で行う．
+  ymuint rem = mPrimNum % 64;
+  ymuint64 last_mask = (rem == 0) ? ~0ULL : (1ULL << rem) - 1ULL;
+  vector<ymuint64> coef(static_cast<ymuint64>(num) * mCoefSize);
+  const ymuint kEmpty = 0xFFFFFFFFU;
+  ymuint64 table_size = 16;
+  while ( table_size < static_cast<ymuint64>(num) * 2 ) {
+    table_size <<= 1;
+  }
+  ymuint64 mask = table_size - 1;
+  vector<ymuint> coef_table(table_size, kEmpty);
+  for (ymuint i = 0; i < num; ++ i) {
+    ymuint64* row = &coef[static_cast<ymuint64>(i) * mCoefSize];
+    for ( ; ; ) {
+      bool zero = true;
+      for (ymuint j = 0; j < mCoefSize; ++ j) {
+	ymuint64 w = rg.int64();
+	if ( j == mCoefSize - 1 ) {
+	  w &= last_mask;
+	}
+	row[j] = w;
+	if ( w != 0ULL ) {
+	  zero = false;
+	}
+      }
+      if ( zero ) {
+	continue;
+      }
+      bool found = false;
+      ymuint64 pos = coef_hash(row, mCoefSize) & mask;
+      for ( ; coef_table[pos] != kEmpty; pos = (pos + 1) & mask) {
+	const ymuint64* row1 = &coef[static_cast<ymuint64>(coef_table[pos]) * mCoefSize];
+	if ( std::equal(row, row + mCoefSize, row1) ) {
+	  found = true;
+	  break;
+	}
+      }
+      if ( !found ) {
+	coef_table[pos] = i;
+	break;
+      }
+    }
+  }
+
+  // 積を求めて変数と価値を取り出す．
+  // 各行の前半はそのまま Variable のブロック列となる．
+  vector<ymuint64> dst;
+  ymuint nc = mRowSize - mVarBlock;
+  for (ymuint base = 0; base < num; base += kBatchSize) {
+    ymuint n = num - base;
+    if ( n > kBatchSize ) {
+      n = kBatchSize;
+    }
+    dst.assign(static_cast<ymuint64>(n) * mRowSize, 0ULL);
+    multiply(&coef[static_cast<ymuint64>(base) * mCoefSize], n, &dst[0]);
+    for (ymuint r = 0; r < n; ++ r) {
+      const ymuint64* row = &dst[static_cast<ymuint64>(r) * mRowSize];
+      var_list.push_back(Variable(row, mVarSize));
+      ymuint64 n1 = (nc > 0) ? RvMatrix::count_bits(row + mVarBlock, nc) : 0;
+      val_list.push_back(Variable::calc_value(mVectNum - n1, n1));
+    }
+    if ( progress && !progress(var_list.size()) ) {
+      break;
+    }
+  }
+}
+
+// @brief 係数行列の積を求める．
+// @param[in] coef 係数行列(1行あたり mCoefSize ブロック)
+// @param[in] row_num 係数行列の行数
+// @param[out] dst 積(1行あたり mRowSize ブロック)
+//
+// dst は 0 で初期化されていなければならない．
+void
+CombGen::multiply(const ymuint64* coef,
+		  ymuint row_num,
+		  ymuint64* dst) const
+{
+  ymuint ng = (mPrimNum + 7) / 8;
+  vector<ymuint64> table(256 * kChunkSize);
+  for (ymuint c0 = 0; c0 < mRowSize; c0 += kChunkSize) {
+    ymuint cw = mRowSize - c0;
+    if ( cw > kChunkSize ) {
+      cw = kChunkSize;
+    }
+    for (ymuint g = 0; g < ng; ++ g) {
+      // B の 8g 行目から 8 行の XOR の表を作る．
+      // table[m] は m の 1 のビットに対応する行の XOR
+      for (ymuint w = 0; w < cw; ++ w) {
+	table[w] = 0ULL;
+      }
+      for (ymuint m = 1; m < 256; ++ m) {
+	ymuint b = __builtin_ctz(m);
+	const ymuint64* src = &mBody[static_cast<ymuint64>(g * 8 + b) * mRowSize + c0];
+	const ymuint64* prev = &table[(m & (m - 1)) * cw];
+	ymuint64* t = &table[m * cw];
+	for (ymuint w = 0; w < cw; ++ w) {
+	  t[w] = prev[w] ^ src[w];
+	}
+      }
+
+      // 係数の 8 ビットで表を引いて足し込む．
+      for (ymuint r = 0; r < row_num; ++ r) {
+	ymuint64 c = coef[static_cast<ymuint64>(r) * mCoefSize + g / 8];
+	ymuint m = (c >> ((g % 8) * 8)) & 0xFFU;
+	if ( m == 0 ) {
+	  continue;
+	}
+	const ymuint64* t = &table[m * cw];
+	ymuint64* d = dst + static_cast<ymuint64>(r) * mRowSize + c0;
+	for (ymuint w = 0; w < cw; ++ w) {
+	  d[w] ^= t[w];
+	}
+      }
+    }
+  }
+}
+
+END_NAMESPACE_IGF
@@ -0,0 +1,118 @@
+#ifndef COMBGEN_H
+#define COMBGEN_H
+
+/// @file CombGen.h
+/// @brief CombGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+#include "RandStream.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class CombGen CombGen.h "CombGen.h"
+/// @brief プライマリ変数のランダムな線形結合をまとめて作るクラス
+///
+/// プライマリ変数ごとに [変数のビットベクタ | 分類結果] を1行とする
+/// 行列 B を作っておき，ランダムな係数行列 A (num 行 × プライマリ変数数)
+/// との GF(2) 上の積 A × B を一度に求める．
+/// 積の各行の前半が合成変数，後半がその分類結果となるので，
+/// 変数と価値が同時に得られる．
+///
+/// 積は 8 行ずつの組ごとに 256 通りの XOR の表を作って求める
+/// (Method of Four Russians)．
+//////////////////////////////////////////////////////////////////////
+class CombGen
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] rv_mat 登録ベクタの行列
+  /// @param[in] pvar_list プライマリ変数のリスト
+  CombGen(const RvMatrix& rv_mat,
+	  const vector<Variable>& pvar_list);
+
+  /// @brief デストラクタ
+  ~CombGen();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief ランダムな合成変数を作る．
+  /// @param[in] rg 係数を選ぶための乱数の系列
+  /// @param[in] num 作る変数の数
+  /// @param[out] var_list 合成変数のリスト
+  /// @param[out] val_list 価値のリスト(var_list と同じ順)
+  /// @param[in] progress 途中経過を受け取る関数
+  ///
+  /// 係数は 0 でなく互いに異なるものを選ぶ．
+  /// 異なる係数が num 個ない時は作れるだけ作る．
+  ///
+  /// progress が空でない時は積を一まとまり求めるごとに
+  /// それまでに作った変数の数を引数にして呼ぶ．
+  /// progress が false を返したらそこで打ち切る．
+  void
+  generate(RandStream& rg,
+	   ymuint num,
+	   vector<Variable>& var_list,
+	   vector<double>& val_list,
+	   const std::function<bool (ymuint)>& progress = nullptr);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 係数行列の積を求める．
+  /// @param[in] coef 係数行列(1行あたり mCoefSize ブロック)
+  /// @param[in] row_num 係数行列の行数
+  /// @param[out] dst 積(1行あたり mRowSize ブロック)
+  void
+  multiply(const ymuint64* coef,
+	   ymuint row_num,
+	   ymuint64* dst) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 登録ベクタ数
+  ymuint64 mVectNum;
+
+  // 入力数
+  ymuint mVarSize;
+
+  // プライマリ変数の数
+  ymuint mPrimNum;
+
+  // 係数行列の1行のブロック数
+  ymuint mCoefSize;
+
+  // 変数部分のブロック数
+  ymuint mVarBlock;
+
+  // B の1行のブロック数
+  ymuint mRowSize;
+
+  // 行列 B
+  // 8 の倍数の行数になるように 0 の行を補っておく．
+  vector<ymuint64> mBody;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // COMBGEN_H
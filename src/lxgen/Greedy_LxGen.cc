@@ -8,8 +8,9 @@
 
 
 #include "Greedy_LxGen.h"
-#include "RegVect.h"
+#include "RvMatrix.h"
 #include "Variable.h"
+#include "ClassBits.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -32,61 +33,114 @@ Greedy_LxGen::~Greedy_LxGen()
 // @param[in] rv_list 登録ベクタのリスト
 // @param[in] req_num 出力する合成変数の数
 // @param[out] var_list 結果の変数を入れるリスト
-//
-// var_list の内容の Variable は呼んだ側で解放すること．
 void
 Greedy_LxGen::generate(const vector<const RegVect*>& rv_list,
 		    ymuint req_num,
 		    vector<Variable>& var_list)
 {
+  start_budget();
+
+  // 価値の計算は連続領域に格納した行列で行う．
+  RvMatrix rv_mat(rv_list);
+
   // 初期変数集合を作る．
   vector<Variable> pvar_list;
-  get_primary_vars(rv_list, pvar_list);
+  get_primary_vars(rv_mat, pvar_list);
 
-  // 最初のシードをランダムに作り，
-  // 評価値の最も高くなる変数と合成してゆく．
   var_list.clear();
-  var_list.reserve(req_num);
-  for (ymuint i = 0; i < req_num; ++ i) {
-    // var_list の中からランダムに選ぶ．
-    // といっても choose_var() を呼ぶとその変数は
-    // リストから取り除かれるのでコピーを使う．
-    vector<Variable> tmp_list(pvar_list);
-
-    // シードとなる変数をランダムに選ぶ．
-    Variable var1 = choose_var(tmp_list);
-
-    // ランダムに変数を足していって価値の最も高いものを返す．
-    // いわゆる山登り法
-    double max_val = var1.value(rv_list);
-    Variable max_var = var1;
-    while ( !tmp_list.empty() ) {
-      Variable var2 = choose_var(tmp_list);
-      var1 *= var2;
-      double val = var1.value(rv_list);
-      if ( max_val < val ) {
-	max_val = val;
-	max_var = var1;
+  ymuint np = pvar_list.size();
+  if ( np == 0 ) {
+    finish_budget();
+    return;
+  }
+
+  // 初期変数の分類結果を求めておく．
+  vector<ClassBits> pbits_list(np);
+  for (ymuint i = 0; i < np; ++ i) {
+    pbits_list[i].set(rv_mat, pvar_list[i]);
+  }
+  ymuint64 nv = rv_mat.vect_num();
+
+  // 1回の試行は np * column_size() ブロック程度の仕事なので
+  // 1スレッドあたり kGrainBlocks ブロック程度の仕事がない時は分割しない．
+  const ymuint64 kGrainBlocks = 16384;
+  ymuint grain = kGrainBlocks / (static_cast<ymuint64>(np) * rv_mat.column_size() + 1) + 1;
+
+  // consume() を呼ぶ間隔(合成の回数)
+  const ymuint64 kCheckInterval = 256;
+
+  // 打ち切られた時は終わった回の結果のみを返す．
+  vector<char> done_list(req_num, 0);
+  var_list.resize(req_num);
+  parallel_for(req_num, [&](ymuint begin, ymuint end) {
+      vector<ymuint> order(np);
+      ClassBits bits1;
+      ymuint64 pending = 0;
+      double best_val = 0.0;
+      for (ymuint i = begin; i < end && running(); ++ i) {
+	RandStream rg = rand_stream().split(i);
+	for (ymuint j = 0; j < np; ++ j) {
+	  order[j] = j;
+	}
+
+	// order をランダムに並べ替えながら先頭から順に合成していく．
+	// いわゆる山登り法
+	// 合成した変数の分類結果は分類結果の XOR で求めるので
+	// 1ステップあたりの計算は XOR と popcount のみとなる．
+	// 変数そのものは最後に order の先頭 max_len 個から作る．
+	double max_val = 0.0;
+	ymuint max_len = 0;
+	for (ymuint k = 0; k < np; ++ k) {
+	  ymuint idx = k + rg.int32() % (np - k);
+	  std::swap(order[k], order[idx]);
+	  ymuint pos = order[k];
+	  ymuint64 n1;
+	  if ( k == 0 ) {
+	    bits1 = pbits_list[pos];
+	    n1 = bits1.count1();
+	  }
+	  else {
+	    n1 = (bits1 *= pbits_list[pos]);
+	  }
+	  double val = Variable::calc_value(nv - n1, n1);
+	  if ( k == 0 || max_val < val ) {
+	    max_val = val;
+	    max_len = k + 1;
+	  }
+	}
+
+	Variable max_var = pvar_list[order[0]];
+	for (ymuint k = 1; k < max_len; ++ k) {
+	  max_var *= pvar_list[order[k]];
+	}
+	var_list[i] = std::move(max_var);
+	done_list[i] = 1;
+
+	pending += np;
+	if ( best_val < max_val ) {
+	  best_val = max_val;
+	}
+	if ( pending >= kCheckInterval ) {
+	  consume(pending, best_val);
+	  pending = 0;
+	}
+      }
+      consume(pending, best_val);
+    }, grain);
+
+  if ( interrupted() ) {
+    ymuint wpos = 0;
+    for (ymuint i = 0; i < req_num; ++ i) {
+      if ( done_list[i] ) {
+	if ( wpos != i ) {
+	  var_list[wpos] = std::move(var_list[i]);
+	}
+	++ wpos;
       }
     }
-    var_list.push_back(max_var);
+    var_list.resize(wpos);
   }
-}
-
-// @brief var_list の中からランダムに変数を選ぶ．
-// @param[inout] var_list 変数のリスト
-//
-// 選ばれた変数は var_list から取り除かれる．
-Variable
-Greedy_LxGen::choose_var(vector<Variable>& var_list)
-{
-  ymuint n = var_list.size();
-  ymuint pos = mRandGen.int32() % n;
-  Variable var = var_list[pos];
-  const Variable& last_var = var_list[n - 1];
-  var_list[pos] = last_var;
-  var_list.erase(var_list.end() - 1, var_list.end());
-  return var;
+  finish_budget();
 }
 
 END_NAMESPACE_IGF
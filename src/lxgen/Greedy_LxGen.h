@@ -10,7 +10,6 @@
 
 
 #include "LxGenBase.h"
-#include "ym/RandGen.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -18,6 +17,11 @@ BEGIN_NAMESPACE_IGF
 //////////////////////////////////////////////////////////////////////
 /// @class Greedy_LxGen Greedy_LxGen.h "Greedy_LxGen.h"
 /// @brief 線形変換用の合成変数を生成するクラス
+///
+/// プライマリ変数をランダムな順に合成していき，
+/// その途中で価値の最も高かった変数を選ぶことを req_num 回行う．
+/// 各回は独立しており，i 回目は rand_stream().split(i) を用いるので
+/// thread_num() 個のスレッドで分担しても結果は変わらない．
 //////////////////////////////////////////////////////////////////////
 class Greedy_LxGen :
   public LxGenBase
@@ -48,27 +52,11 @@ public:
 	   vector<Variable>& var_list);
 
 
-private:
-  //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
-  //////////////////////////////////////////////////////////////////////
-
-  /// @brief var_list の中からランダムに変数を選ぶ．
-  /// @param[inout] var_list 変数のリスト
-  ///
-  /// 選ばれた変数は var_list から取り除かれる．
-  Variable
-  choose_var(vector<Variable>& var_list);
-
-
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 変数を選ぶための乱数発生器
-  RandGen mRandGen;
-
 };
 
 END_NAMESPACE_IGF
@@ -8,12 +8,17 @@
 
 
 #include "LxGen.h"
+#include "Anneal_LxGen.h"
+#include "Basis_LxGen.h"
 #include "Greedy_LxGen.h"
 #include "MCMC_LxGen.h"
 #include "MCMC2_LxGen.h"
 #include "MCMC3_LxGen.h"
+#include "Partition_LxGen.h"
 #include "Shift_LxGen.h"
 #include "Simple_LxGen.h"
+#include "Tempering_LxGen.h"
+#include <thread>
 
 
 BEGIN_NAMESPACE_IGF
@@ -23,6 +28,12 @@ BEGIN_NAMESPACE_IGF
 LxGen*
 LxGen::new_obj(string method)
 {
+  if ( method == "Anneal" ) {
+    return new Anneal_LxGen();
+  }
+  if ( method == "Basis" ) {
+    return new Basis_LxGen();
+  }
   if ( method == "Greedy" ) {
     return new Greedy_LxGen();
   }
@@ -35,14 +46,184 @@ LxGen::new_obj(string method)
   if ( method == "MCMC3" ) {
     return new MCMC3_LxGen();
   }
+  if ( method == "Partition" ) {
+    return new Partition_LxGen();
+  }
   if ( method == "Shift" ) {
     return new Shift_LxGen();
   }
   if ( method == "Simple" ) {
     return new Simple_LxGen();
   }
+  if ( method == "Tempering" ) {
+    return new Tempering_LxGen();
+  }
   cerr << "Error in LxGen::new_obj(" << method << "): illegal method" << endl;
   return nullptr;
 }
 
+// @brief コンストラクタ
+LxGen::LxGen() :
+  mThreadNum(1),
+  mChainNum(1),
+  mTimeLimit(0.0),
+  mStepLimit(0),
+  mInterval(1.0),
+  mStepCount(0),
+  mStop(false),
+  mRank(0),
+  mFullRank(0),
+  mCancel(false),
+  mBestValue(0.0),
+  mLastReport(0.0)
+{
+}
+
+// @brief 用いるスレッド数を設定する．
+// @param[in] thread_num スレッド数
+void
+LxGen::set_thread_num(ymuint thread_num)
+{
+  if ( thread_num == 0 ) {
+    thread_num = std::thread::hardware_concurrency();
+    if ( thread_num == 0 ) {
+      thread_num = 1;
+    }
+  }
+  mThreadNum = thread_num;
+}
+
+// @brief 独立に動かす探索の数(連鎖数)を設定する．
+// @param[in] chain_num 連鎖数 ( > 0 )
+void
+LxGen::set_chain_num(ymuint chain_num)
+{
+  ASSERT_COND( chain_num > 0 );
+  mChainNum = chain_num;
+}
+
+// @brief 時間の上限を設定する．
+// @param[in] sec 秒数
+void
+LxGen::set_time_limit(double sec)
+{
+  mTimeLimit = sec;
+}
+
+// @brief 評価する候補の数の上限を設定する．
+// @param[in] step_num 候補の数
+void
+LxGen::set_step_limit(ymuint64 step_num)
+{
+  mStepLimit = step_num;
+}
+
+// @brief 途中経過を受け取る関数を設定する．
+// @param[in] observer 途中経過を受け取る関数
+// @param[in] interval 呼び出しの間隔(秒)
+void
+LxGen::set_observer(const std::function<void (const LxGenStats&)>& observer,
+		    double interval)
+{
+  mObserver = observer;
+  mInterval = interval;
+}
+
+// @brief 実行中の generate() を打ち切る．
+void
+LxGen::cancel()
+{
+  mCancel = true;
+}
+
+// @brief 上限の管理を開始する．
+void
+LxGen::start_budget()
+{
+  mStartTime = std::chrono::steady_clock::now();
+  mStepCount = 0;
+  mStop = false;
+  mRank = 0;
+  mFullRank = 0;
+  mBestValue = 0.0;
+  mLastReport = 0.0;
+}
+
+// @brief 評価した候補の数を加えて上限をチェックする．
+// @param[in] step_num 前回の呼び出しから評価した候補の数
+// @param[in] best_value 呼び出し側で得られた最良の価値
+// @return 処理を続けてよい時 true を返す．
+bool
+LxGen::consume(ymuint64 step_num,
+	       double best_value)
+{
+  ymuint64 count = (mStepCount += step_num);
+  if ( mCancel ) {
+    mStop = true;
+  }
+  if ( mStepLimit > 0 && count >= mStepLimit ) {
+    mStop = true;
+  }
+  if ( mTimeLimit > 0.0 || mObserver ) {
+    std::chrono::duration<double> d = std::chrono::steady_clock::now() - mStartTime;
+    double t = d.count();
+    if ( mTimeLimit > 0.0 && t >= mTimeLimit ) {
+      mStop = true;
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    if ( mBestValue < best_value ) {
+      mBestValue = best_value;
+    }
+    if ( mObserver && t - mLastReport >= mInterval ) {
+      mLastReport = t;
+      LxGenStats stats;
+      stats.mTime = t;
+      stats.mStepNum = count;
+      stats.mStepRate = t > 0.0 ? count / t : 0.0;
+      stats.mBestValue = mBestValue;
+      stats.mRank = mRank;
+      stats.mFullRank = mFullRank;
+      stats.mInterrupted = false;
+      mObserver(stats);
+    }
+  }
+  return !mStop;
+}
+
+// @brief 結果の階数を設定する．
+// @param[in] rank それまでに得られた変数の階数
+// @param[in] full_rank プライマリ変数の階数
+void
+LxGen::set_rank(ymuint rank,
+		ymuint full_rank)
+{
+  mRank = rank;
+  mFullRank = full_rank;
+}
+
+// @brief 上限の管理を終了する．
+void
+LxGen::finish_budget()
+{
+  // 打ち切り要求はこの generate() で受け付けたことにする．
+  if ( mCancel.exchange(false) ) {
+    mStop = true;
+  }
+  if ( !mObserver ) {
+    return;
+  }
+  std::chrono::duration<double> d = std::chrono::steady_clock::now() - mStartTime;
+  double t = d.count();
+  std::lock_guard<std::mutex> lock(mMutex);
+  LxGenStats stats;
+  stats.mTime = t;
+  stats.mStepNum = mStepCount;
+  stats.mStepRate = t > 0.0 ? mStepCount / t : 0.0;
+  stats.mBestValue = mBestValue;
+  stats.mRank = mRank;
+  stats.mFullRank = mFullRank;
+  stats.mInterrupted = mStop;
+  mObserver(stats);
+}
+
 END_NAMESPACE_IGF
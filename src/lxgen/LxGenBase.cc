@@ -8,7 +8,7 @@
 
 
 #include "LxGenBase.h"
-#include "RegVect.h"
+#include "RvMatrix.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -28,28 +28,34 @@ LxGenBase::~LxGenBase()
 }
 
 // @brief 初期変数集合を求める．
-// @param[in] rv_list 登録ベクタのリスト
+// @param[in] rv_mat 登録ベクタの行列
 // @param[out] var_list 変数を格納するリスト
 //
 // 基本的にはすべての変数が対象だが，
 // 登録ベクタを区別しない変数は取り除く．
 void
-LxGenBase::get_primary_vars(const vector<const RegVect*>& rv_list,
+LxGenBase::get_primary_vars(const RvMatrix& rv_mat,
 			    vector<Variable>& var_list)
 {
-  ymuint var_num = 0;
-  {
-    ASSERT_COND( !rv_list.empty() );
-    const RegVect* rv0 = rv_list[0];
-    var_num = rv0->size();
+  ASSERT_COND( rv_mat.vect_num() > 0 );
+  ymuint var_num = rv_mat.vect_size();
+  vector<Variable> cand_list;
+  cand_list.reserve(var_num);
+  for (ymuint i = 0; i < var_num; ++ i) {
+    cand_list.push_back(Variable(var_num, i));
   }
+
+  // すべての変数の分類をまとめて行う．
+  vector<ymuint64> n1_list;
+  rv_mat.count1(cand_list, n1_list);
+
+  ymuint64 nv = rv_mat.vect_num();
   var_list.clear();
   var_list.reserve(var_num);
   for (ymuint i = 0; i < var_num; ++ i) {
-    Variable var1(var_num, i);
-    double v = var1.value(rv_list);
-    if ( v > 0.0 ) {
-      var_list.push_back(var1);
+    ymuint64 n1 = n1_list[i];
+    if ( n1 > 0 && n1 < nv ) {
+      var_list.push_back(cand_list[i]);
     }
   }
 }
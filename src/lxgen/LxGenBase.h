@@ -10,6 +10,7 @@
 
 
 #include "LxGen.h"
+#include <thread>
 
 
 BEGIN_NAMESPACE_IGF
@@ -43,15 +44,30 @@ protected:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 初期変数集合を求める．
-  /// @param[in] rv_list 登録ベクタのリスト
+  /// @param[in] rv_mat 登録ベクタの行列
   /// @param[out] var_list 変数を格納するリスト
   ///
   /// 基本的にはすべての変数が対象だが，
   /// 登録ベクタを区別しない変数は取り除く．
   void
-  get_primary_vars(const vector<const RegVect*>& rv_list,
+  get_primary_vars(const RvMatrix& rv_mat,
 		   vector<Variable>& var_list);
 
+  /// @brief 範囲を分割して並列に処理する．
+  /// @param[in] n 要素数
+  /// @param[in] func 処理を行う関数
+  /// @param[in] grain 1スレッドあたりの最小の要素数
+  ///
+  /// [0, n) を thread_num() 個の連続した範囲 [begin, end) に分けて
+  /// それぞれ別のスレッドで func(begin, end) を呼ぶ．
+  /// 分割数は各範囲が grain 個以上となるように減らす．
+  /// 分割数が 1 の時は呼び出したスレッドで func(0, n) を呼ぶ．
+  template<typename Func>
+  void
+  parallel_for(ymuint n,
+	       Func func,
+	       ymuint grain = 1) const;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -61,6 +77,45 @@ private:
 
 };
 
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 範囲を分割して並列に処理する．
+// @param[in] n 要素数
+// @param[in] func 処理を行う関数
+// @param[in] grain 1スレッドあたりの最小の要素数
+template<typename Func>
+inline
+void
+LxGenBase::parallel_for(ymuint n,
+			Func func,
+			ymuint grain) const
+{
+  ymuint nt = thread_num();
+  if ( grain == 0 ) {
+    grain = 1;
+  }
+  if ( nt > n / grain ) {
+    nt = n / grain;
+  }
+  if ( nt <= 1 ) {
+    func(0, n);
+    return;
+  }
+  vector<std::thread> thread_list;
+  thread_list.reserve(nt);
+  for (ymuint t = 0; t < nt; ++ t) {
+    ymuint begin = static_cast<ymuint>((static_cast<ymuint64>(n) * t) / nt);
+    ymuint end = static_cast<ymuint>((static_cast<ymuint64>(n) * (t + 1)) / nt);
+    thread_list.push_back(std::thread(func, begin, end));
+  }
+  for (ymuint t = 0; t < nt; ++ t) {
+    thread_list[t].join();
+  }
+}
+
 END_NAMESPACE_IGF
 
 #endif // LXGENBASE_H
@@ -8,7 +8,6 @@
 
 
 #include "MCMC2_LxGen.h"
-#include "RegVect.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -28,22 +27,12 @@ MCMC2_LxGen::~MCMC2_LxGen()
 }
 
 // @brief 変数の価値を計算する．
+// @param[in] n0 0 に分類されたベクタ数
+// @param[in] n1 1 に分類されたベクタ数
 double
-MCMC2_LxGen::value(const Variable& var)
+MCMC2_LxGen::value(ymuint64 n0,
+		   ymuint64 n1)
 {
-  ymuint64 n0 = 0;
-  ymuint64 n1 = 0;
-  for (vector<const RegVect*>::const_iterator p = rv_list().begin();
-       p != rv_list().end(); ++ p) {
-    const RegVect* rv = *p;
-    if ( rv->classify(var) ) {
-      ++ n1;
-    }
-    else {
-      ++ n0;
-    }
-  }
-
   if ( n0 > n1 ) {
     return static_cast<double>(n1) / static_cast<double>(n0);
   }
@@ -37,9 +37,12 @@ private:
   //////////////////////////////////////////////////////////////////////
 
   /// @brief 変数の価値を計算する．
+  /// @param[in] n0 0 に分類されたベクタ数
+  /// @param[in] n1 1 に分類されたベクタ数
   virtual
   double
-  value(const Variable& var);
+  value(ymuint64 n0,
+	ymuint64 n1);
 
 
 private:
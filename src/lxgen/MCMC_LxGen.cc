@@ -8,18 +8,27 @@
 
 
 #include "MCMC_LxGen.h"
-#include "RegVect.h"
 #include "VarPool.h"
+#include <thread>
+#include <cmath>
 
 
 BEGIN_NAMESPACE_IGF
 
+BEGIN_NONAMESPACE
+
+// consume() を呼ぶ間隔(遷移の回数)
+const ymuint kCheckInterval = 256;
+
+END_NONAMESPACE
+
 //////////////////////////////////////////////////////////////////////
 // クラス MCMC_LxGen
 //////////////////////////////////////////////////////////////////////
 
 // @brief コンストラクタ
-MCMC_LxGen::MCMC_LxGen()
+MCMC_LxGen::MCMC_LxGen() :
+  mStepFactor(5)
 {
 }
 
@@ -37,12 +46,51 @@ MCMC_LxGen::generate(const vector<const RegVect*>& rv_list,
 		     ymuint req_num,
 		     vector<Variable>& var_list)
 {
+  start_budget();
   init(rv_list);
 
+  ymuint step_num = this->step_num(req_num);
+  ymuint chain_num = this->chain_num();
+
   VarPool var_pool(req_num);
-  for (ymuint i = 0; i < req_num * 5; ++ i) {
-    next_move();
-    var_pool.put(mCurState, mCurVal);
+  if ( chain_num <= 1 ) {
+    run_chain(0, step_num, var_pool);
+  }
+  else {
+    // 連鎖ごとのプールに貯めてから一つにまとめる．
+    vector<VarPool*> pool_list(chain_num);
+    for (ymuint cid = 0; cid < chain_num; ++ cid) {
+      pool_list[cid] = new VarPool(req_num);
+    }
+    ymuint tnum = thread_num();
+    if ( tnum > chain_num ) {
+      tnum = chain_num;
+    }
+    auto run = [this, tnum, chain_num, step_num, &pool_list](ymuint tid) {
+      for (ymuint cid = tid; cid < chain_num; cid += tnum) {
+	run_chain(cid, step_num, *pool_list[cid]);
+      }
+    };
+    if ( tnum <= 1 ) {
+      run(0);
+    }
+    else {
+      vector<std::thread> thread_list;
+      thread_list.reserve(tnum);
+      for (ymuint tid = 0; tid < tnum; ++ tid) {
+	thread_list.push_back(std::thread(run, tid));
+      }
+      for (ymuint tid = 0; tid < tnum; ++ tid) {
+	thread_list[tid].join();
+      }
+    }
+    for (ymuint cid = 0; cid < chain_num; ++ cid) {
+      VarPool& pool1 = *pool_list[cid];
+      for (ymuint i = 0; i < pool1.size(); ++ i) {
+	var_pool.put(pool1.var(i), pool1.value(i));
+      }
+      delete pool_list[cid];
+    }
   }
 
   var_list.clear();
@@ -50,6 +98,23 @@ MCMC_LxGen::generate(const vector<const RegVect*>& rv_list,
   for (ymuint i = 0; i < var_pool.size(); ++ i) {
     var_list.push_back(var_pool.var(i));
   }
+  finish_budget();
+}
+
+// @brief 1連鎖あたりの遷移の回数を設定する．
+// @param[in] factor 生成する変数の数に対する倍率
+void
+MCMC_LxGen::set_step_factor(ymuint factor)
+{
+  mStepFactor = factor;
+}
+
+// @brief 1連鎖あたりの遷移の回数を返す．
+// @param[in] req_num 生成する変数の数
+ymuint
+MCMC_LxGen::step_num(ymuint req_num) const
+{
+  return req_num * mStepFactor;
 }
 
 // @brief 初期化を行う．
@@ -60,67 +125,181 @@ MCMC_LxGen::init(const vector<const RegVect*>& rv_list)
   // 初期変数集合を作る．
   // 基本的にはすべての変数が対象だが，
   // 登録ベクタを区別しない変数は取り除く．
-  ymuint var_num = 0;
-  {
-    ASSERT_COND( !rv_list.empty() );
-    const RegVect* rv0 = rv_list[0];
-    var_num = rv0->size();
-  }
+  ASSERT_COND( !rv_list.empty() );
 
-  mRvList = rv_list;
+  mRvMatrix.set(rv_list);
+  ymuint var_num = mRvMatrix.vect_size();
 
+  // 分類結果は転置した行列の列そのもの
   mPrimaryList.clear();
   mPrimaryList.reserve(var_num);
+  mPrimaryBits.clear();
+  mPrimaryBits.reserve(var_num);
   for (ymuint i = 0; i < var_num; ++ i) {
-    Variable var1(var_num, i);
-    double v = var1.value(mRvList);
-    if ( v > 0.0 ) {
-      mPrimaryList.push_back(var1);
+    ClassBits bits;
+    bits.set_primary(mRvMatrix, i);
+    ymuint64 n1 = bits.count1();
+    if ( n1 > 0 && n1 < mRvMatrix.vect_num() ) {
+      mPrimaryList.push_back(Variable(var_num, i));
+      mPrimaryBits.push_back(bits);
     }
   }
+}
+
+// @brief 連鎖の初期化を行う．
+// @param[in] cid 連鎖番号
+// @param[out] chain 対象の連鎖
+void
+MCMC_LxGen::init_chain(ymuint cid,
+		       Chain& chain)
+{
+  RandStream rs = rand_stream().split(cid);
+  chain.mRgMove = rs.split(0);
+  chain.mRgAccept = rs.split(1);
 
   // 初期解を作る．
-  ymuint vid = mRgMove.int32() % var_num;
-  mCurState = Variable(var_num, vid);
-  mCurVal = value(mCurState);
+  ymuint var_num = mRvMatrix.vect_size();
+  ymuint vid = chain.mRgMove.int32() % var_num;
+  chain.mCurState = Variable(var_num, vid);
+  chain.mCurBits.set_primary(mRvMatrix, vid);
+  ymuint64 n1 = chain.mCurBits.count1();
+  chain.mCurVal = value(mRvMatrix.vect_num() - n1, n1);
+  chain.mBestVal = chain.mCurVal;
+  chain.mPendingNum = 0;
 }
 
-// @brief 次の状態に遷移する．
+// @brief 遷移の回数を数えて上限をチェックする．
+// @param[inout] chain 対象の連鎖
+// @return 処理を続けてよい時 true を返す．
+bool
+MCMC_LxGen::count_step(Chain& chain)
+{
+  if ( chain.mBestVal < chain.mCurVal ) {
+    chain.mBestVal = chain.mCurVal;
+  }
+  ++ chain.mPendingNum;
+  if ( chain.mPendingNum >= kCheckInterval ) {
+    flush_step(chain);
+  }
+  return running();
+}
+
+// @brief 数えた遷移の回数の残りを consume() に渡す．
+// @param[inout] chain 対象の連鎖
 void
-MCMC_LxGen::next_move()
+MCMC_LxGen::flush_step(Chain& chain)
+{
+  consume(chain.mPendingNum, chain.mBestVal);
+  chain.mPendingNum = 0;
+}
+
+// @brief 連鎖を動かす．
+// @param[in] cid 連鎖番号
+// @param[in] step_num 遷移の回数
+// @param[out] var_pool 訪れた状態を格納するプール
+void
+MCMC_LxGen::run_chain(ymuint cid,
+		      ymuint step_num,
+		      VarPool& var_pool)
+{
+  Chain chain;
+  init_chain(cid, chain);
+  var_pool.put(chain.mCurState, chain.mCurVal);
+  for (ymuint i = 0; i < step_num; ++ i) {
+    next_move(chain);
+    var_pool.put(chain.mCurState, chain.mCurVal);
+    if ( !count_step(chain) ) {
+      break;
+    }
+  }
+  flush_step(chain);
+}
+
+// @brief 遷移先の候補を作る．
+// @param[inout] chain 対象の連鎖
+// @param[out] new_val 遷移先の価値
+// @return 合成するプライマリ変数の位置を返す．
+ymuint
+MCMC_LxGen::propose(Chain& chain,
+		    double& new_val)
 {
   // mPrimaryList の中からランダムに選ぶ．
-  ymuint pos = mRgMove.int32() % mPrimaryList.size();
-  const Variable& var1 = mPrimaryList[pos];
+  ymuint pos = chain.mRgMove.int32() % mPrimaryList.size();
   // 今の変数と合成する．
-  Variable new_var = mCurState * var1;
-  double new_val = value(new_var);
-  if ( new_val < mCurVal ) {
+  // 分類結果は今の変数の分類結果との XOR で求まる．
+  ymuint64 n1 = chain.mCurBits.compose(mPrimaryBits[pos], chain.mNewBits);
+  new_val = value(mRvMatrix.vect_num() - n1, n1);
+  return pos;
+}
+
+// @brief 遷移先の候補を受容する．
+// @param[inout] chain 対象の連鎖
+// @param[in] pos propose() の返り値
+// @param[in] new_val 遷移先の価値
+void
+MCMC_LxGen::accept(Chain& chain,
+		   ymuint pos,
+		   double new_val)
+{
+  chain.mCurState *= mPrimaryList[pos];
+  chain.mCurBits.swap(chain.mNewBits);
+  chain.mCurVal = new_val;
+}
+
+// @brief 次の状態に遷移する．
+// @param[inout] chain 対象の連鎖
+void
+MCMC_LxGen::next_move(Chain& chain)
+{
+  double new_val;
+  ymuint pos = propose(chain, new_val);
+  if ( new_val < chain.mCurVal ) {
     // 価値が減っていたら価値に基づいたランダム判定を行う．
-    double ratio = new_val / mCurVal;
-    double r = mRgAccept.real1();
+    double ratio = new_val / chain.mCurVal;
+    double r = chain.mRgAccept.real1();
     if ( r > ratio ) {
       // 棄却する．
       return;
     }
   }
   // ここに来たということは受容された．
-  mCurState = new_var;
-  mCurVal = new_val;
+  accept(chain, pos, new_val);
+}
+
+// @brief 温度を指定して次の状態に遷移する．
+// @param[inout] chain 対象の連鎖
+// @param[in] temp 温度 ( > 0.0 )
+void
+MCMC_LxGen::metropolis_move(Chain& chain,
+			    double temp)
+{
+  double new_val;
+  ymuint pos = propose(chain, new_val);
+  if ( new_val < chain.mCurVal ) {
+    double r = chain.mRgAccept.real1();
+    if ( r > exp((new_val - chain.mCurVal) / temp) ) {
+      // 棄却する．
+      return;
+    }
+  }
+  accept(chain, pos, new_val);
 }
 
 // @brief 変数の価値を計算する．
+// @param[in] n0 0 に分類されたベクタ数
+// @param[in] n1 1 に分類されたベクタ数
 double
-MCMC_LxGen::value(const Variable& var)
+MCMC_LxGen::value(ymuint64 n0,
+		  ymuint64 n1)
 {
-  return var.value(mRvList);
+  return Variable::calc_value(n0, n1);
 }
 
-// @brief 登録ベクタのリストを返す．
-const vector<const RegVect*>&
-MCMC_LxGen::rv_list() const
+// @brief 登録ベクタの行列を返す．
+const RvMatrix&
+MCMC_LxGen::rv_matrix() const
 {
-  return mRvList;
+  return mRvMatrix;
 }
 
 END_NAMESPACE_IGF
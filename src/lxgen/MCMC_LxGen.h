@@ -10,7 +10,8 @@
 
 
 #include "LxGen.h"
-#include "ym/RandGen.h"
+#include "RvMatrix.h"
+#include "ClassBits.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -18,6 +19,14 @@ BEGIN_NAMESPACE_IGF
 //////////////////////////////////////////////////////////////////////
 /// @class MCMC_LxGen MCMC_LxGen.h "MCMC_LxGen.h"
 /// @brief 線形変換用の合成変数を生成するクラス
+///
+/// 連鎖数(chain_num())個の独立なマルコフ連鎖を
+/// thread_num() 個のスレッドで分担して動かす．
+/// 連鎖ごとに乱数の系列(rand_stream().split(連鎖番号) から派生させたもの)
+/// と VarPool を持ち，最後に連鎖番号の順に一つの VarPool にまとめる．
+/// 連鎖数はスレッド数と無関係に決めるので，結果はスレッド数によらない．
+/// 変数の価値は変数のみで決まるので，連鎖ごとの上位 req_num 個を
+/// まとめたものの上位 req_num 個は全体の上位 req_num 個に等しい．
 //////////////////////////////////////////////////////////////////////
 class MCMC_LxGen :
   public LxGen
@@ -46,35 +55,151 @@ public:
 	   ymuint req_num,
 	   vector<Variable>& var_list);
 
+  /// @brief 1連鎖あたりの遷移の回数を設定する．
+  /// @param[in] factor 生成する変数の数に対する倍率
+  ///
+  /// 遷移の回数は req_num * factor となる．
+  /// デフォルトは 5
+  void
+  set_step_factor(ymuint factor);
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
-  // 継承クラスから用いられる関数
+  // 継承クラスから用いられるデータ型
   //////////////////////////////////////////////////////////////////////
 
-  /// @brief 登録ベクタのリストを返す．
-  const vector<const RegVect*>&
-  rv_list() const;
+  // 一つのマルコフ連鎖の状態
+  struct Chain
+  {
+    // 遷移を行うための乱数の系列
+    RandStream mRgMove;
 
+    // 受容/棄却を決めるための乱数の系列
+    RandStream mRgAccept;
 
-private:
+    // 現在の状態
+    Variable mCurState;
+
+    // 現在の状態の分類結果
+    ClassBits mCurBits;
+
+    // 遷移先の状態の分類結果
+    ClassBits mNewBits;
+
+    // 現在の値
+    double mCurVal;
+
+    // これまでの最良の値
+    double mBestVal;
+
+    // まだ consume() に渡していない遷移の回数
+    ymuint mPendingNum;
+  };
+
+
+protected:
   //////////////////////////////////////////////////////////////////////
-  // 内部で用いられる関数
+  // 継承クラスから用いられる関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief 登録ベクタの行列を返す．
+  const RvMatrix&
+  rv_matrix() const;
+
   /// @brief 初期化を行う．
   /// @param[in] rv_list 登録ベクタのリスト
   void
   init(const vector<const RegVect*>& rv_list);
 
+  /// @brief 連鎖の初期化を行う．
+  /// @param[in] cid 連鎖番号
+  /// @param[out] chain 対象の連鎖
+  ///
+  /// 乱数の系列は rand_stream().split(cid) から派生させる．
+  void
+  init_chain(ymuint cid,
+	     Chain& chain);
+
+  /// @brief 遷移先の候補を作る．
+  /// @param[inout] chain 対象の連鎖
+  /// @param[out] new_val 遷移先の価値
+  /// @return 合成するプライマリ変数の位置を返す．
+  ///
+  /// 遷移先の分類結果は chain.mNewBits に入る．
+  ymuint
+  propose(Chain& chain,
+	  double& new_val);
+
+  /// @brief 遷移先の候補を受容する．
+  /// @param[inout] chain 対象の連鎖
+  /// @param[in] pos propose() の返り値
+  /// @param[in] new_val 遷移先の価値
+  void
+  accept(Chain& chain,
+	 ymuint pos,
+	 double new_val);
+
+  /// @brief 温度を指定して次の状態に遷移する．
+  /// @param[inout] chain 対象の連鎖
+  /// @param[in] temp 温度 ( > 0.0 )
+  ///
+  /// 価値が減る遷移を exp((new_val - cur_val) / temp) の確率で受容する．
+  void
+  metropolis_move(Chain& chain,
+		  double temp);
+
+  /// @brief 1連鎖あたりの遷移の回数を返す．
+  /// @param[in] req_num 生成する変数の数
+  ymuint
+  step_num(ymuint req_num) const;
+
+  /// @brief 遷移の回数を数えて上限をチェックする．
+  /// @param[inout] chain 対象の連鎖
+  /// @return 処理を続けてよい時 true を返す．
+  ///
+  /// 遷移ごとに呼ぶ．consume() はある程度まとめて呼ぶ．
+  bool
+  count_step(Chain& chain);
+
+  /// @brief 数えた遷移の回数の残りを consume() に渡す．
+  /// @param[inout] chain 対象の連鎖
+  void
+  flush_step(Chain& chain);
+
+  /// @brief 連鎖を動かす．
+  /// @param[in] cid 連鎖番号
+  /// @param[in] step_num 遷移の回数
+  /// @param[out] var_pool 訪れた状態を格納するプール
+  ///
+  /// 複数のスレッドから同時に呼ばれる．
+  virtual
+  void
+  run_chain(ymuint cid,
+	    ymuint step_num,
+	    VarPool& var_pool);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
   /// @brief 次の状態に遷移する．
+  /// @param[inout] chain 対象の連鎖
   void
-  next_move();
+  next_move(Chain& chain);
 
   /// @brief 変数の価値を計算する．
+  /// @param[in] n0 0 に分類されたベクタ数
+  /// @param[in] n1 1 に分類されたベクタ数
+  ///
+  /// 変数の価値は分類結果の数のみで決まる．
+  /// 複数のスレッドから同時に呼ばれるので副作用を持ってはいけない．
   virtual
   double
-  value(const Variable& var);
+  value(ymuint64 n0,
+	ymuint64 n1);
 
 
 private:
@@ -82,23 +207,18 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 遷移を行うための乱数発生器
-  RandGen mRgMove;
-
-  // 受容/棄却を決めるための乱数発生器
-  RandGen mRgAccept;
-
-  // 登録ベクタのリスト
-  vector<const RegVect*> mRvList;
+  // 登録ベクタの行列
+  RvMatrix mRvMatrix;
 
   // プライマリ変数のリスト
   vector<Variable> mPrimaryList;
 
-  // 現在の状態
-  Variable mCurState;
+  // プライマリ変数の分類結果のリスト
+  // mPrimaryList と同じ順に並ぶ．
+  vector<ClassBits> mPrimaryBits;
 
-  // 現在の値
-  double mCurVal;
+  // 遷移回数の倍率
+  ymuint mStepFactor;
 
 };
 
@@ -0,0 +1,303 @@
+
+/// @file Partition_LxGen.cc
+/// @brief Partition_LxGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Partition_LxGen.h"
+#include "RvMatrix.h"
+#include "Variable.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 並べ替えた位置でのクラスの範囲 [mBegin, mEnd)
+struct Range
+{
+  ymuint mBegin;
+  ymuint mEnd;
+};
+
+// bits の [0, pos) の範囲の 1 の数を求める．
+// pc[w] は先頭から w - 1 番目までのブロックの 1 の数
+inline
+ymuint64
+count_before(const ymuint64* bits,
+	     const vector<ymuint64>& pc,
+	     ymuint pos)
+{
+  ymuint64 n = pc[pos / 64];
+  ymuint s = pos % 64;
+  if ( s > 0 ) {
+    n += RvMatrix::popcount(bits[pos / 64] & ((1ULL << s) - 1ULL));
+  }
+  return n;
+}
+
+// 64 x 64 のビット行列を転置する．
+// a[i] の j ビット目と a[j] の i ビット目を入れ替える．
+// 対角でない 32 x 32, 16 x 16, ... のブロックを順に交換する．
+void
+transpose64(ymuint64* a)
+{
+  ymuint64 m = 0x00000000FFFFFFFFULL;
+  for (ymuint j = 32; j != 0; j >>= 1, m ^= (m << j)) {
+    for (ymuint k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+      ymuint64 t = ((a[k] >> j) ^ a[k | j]) & m;
+      a[k] ^= t << j;
+      a[k | j] ^= t;
+    }
+  }
+}
+
+// 分類結果 bits によって新たに分離される対の数を求める．
+// pc は作業領域
+ymuint64
+calc_gain(const ymuint64* bits,
+	  ymuint nb,
+	  const vector<Range>& class_list,
+	  vector<ymuint64>& pc)
+{
+  pc[0] = 0;
+  for (ymuint w = 0; w < nb; ++ w) {
+    pc[w + 1] = pc[w] + RvMatrix::popcount(bits[w]);
+  }
+  ymuint64 gain = 0;
+  for (ymuint c = 0; c < class_list.size(); ++ c) {
+    const Range& range = class_list[c];
+    ymuint64 n1 = count_before(bits, pc, range.mEnd) - count_before(bits, pc, range.mBegin);
+    ymuint64 n0 = (range.mEnd - range.mBegin) - n1;
+    gain += n0 * n1;
+  }
+  return gain;
+}
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Partition_LxGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Partition_LxGen::Partition_LxGen() :
+  mTryNum(32)
+{
+}
+
+// @brief デストラクタ
+Partition_LxGen::~Partition_LxGen()
+{
+}
+
+// @brief 合成変数の生成を行う．
+// @param[in] rv_list 登録ベクタのリスト
+// @param[in] req_num 生成する変数の数
+// @param[out] var_list 生成された変数を格納するリスト
+void
+Partition_LxGen::generate(const vector<const RegVect*>& rv_list,
+			  ymuint req_num,
+			  vector<Variable>& var_list)
+{
+  start_budget();
+
+  RvMatrix rv_mat(rv_list);
+  ymuint ni = rv_mat.vect_size();
+  ymuint nv = rv_mat.vect_num();
+  ymuint nb = rv_mat.column_size();
+
+  // プライマリ変数の入力番号のリストを作る．
+  // 登録ベクタを区別しない入力は取り除く．
+  vector<ymuint> prim_list;
+  prim_list.reserve(ni);
+  for (ymuint i = 0; i < ni; ++ i) {
+    ymuint64 n1 = RvMatrix::count_bits(rv_mat.column(i), nb);
+    if ( n1 > 0 && n1 < nv ) {
+      prim_list.push_back(i);
+    }
+  }
+  ymuint np = prim_list.size();
+
+  // 入力番号からプライマリ変数の番号への写像
+  // プライマリ変数でない入力は np とする．
+  vector<ymuint> prim_map(ni, np);
+  for (ymuint i = 0; i < np; ++ i) {
+    prim_map[prim_list[i]] = i;
+  }
+
+  // perm[q] は q 番目の位置に置いたベクタの番号
+  // 2要素以上のクラスに属するベクタのみを先頭から m 個並べる．
+  // 1要素のクラスは分離数に寄与しないので詰めてしまう．
+  ymuint m = nv;
+  vector<ymuint> perm(nv);
+  for (ymuint q = 0; q < nv; ++ q) {
+    perm[q] = q;
+  }
+  vector<ymuint> new_perm(nv);
+
+  // 2要素以上のクラスのリスト
+  vector<Range> class_list;
+  if ( nv >= 2 ) {
+    Range range;
+    range.mBegin = 0;
+    range.mEnd = nv;
+    class_list.push_back(range);
+  }
+  vector<Range> new_class_list;
+
+  // perm の順に並べ替えたプライマリ変数の分類結果
+  // i 番目のプライマリ変数は pbits[i * mb] から mb ブロック
+  ymuint nblk = rv_mat.block_size();
+  ymuint mb = nb;
+  vector<ymuint64> pbits(static_cast<ymuint64>(np) * nb);
+
+  // 途中経過の価値は分離した対の割合とする．
+  double total = static_cast<double>(nv) * static_cast<double>(nv - 1) / 2.0;
+  ymuint64 sep_num = 0;
+
+  vector<ymuint64> gain_list(mTryNum);
+  vector<vector<ymuint> > prefix_list(mTryNum);
+  vector<ymuint64> cur_bits(nb);
+
+  var_list.clear();
+  for (ymuint r = 0; r < req_num && np > 0 && !class_list.empty() && running(); ++ r) {
+    // プライマリ変数の分類結果を今の順に並べ替える．
+    // 行(ベクタ)はブロック単位でそのまま perm の順に集められるので，
+    // 64行ずつ集めて 64 x 64 の転置で列に直す．
+    // 手間はビット単位の並べ替え(np * m)ではなく m * nblk ワード程度となる．
+    mb = (m + 63) / 64;
+    parallel_for(mb, [&](ymuint begin, ymuint end) {
+	ymuint64 tmp[64];
+	for (ymuint w = begin; w < end; ++ w) {
+	  ymuint q0 = w * 64;
+	  for (ymuint j = 0; j < nblk; ++ j) {
+	    for (ymuint i = 0; i < 64; ++ i) {
+	      ymuint q = q0 + i;
+	      tmp[i] = q < m ? rv_mat.row(perm[q])[j] : 0ULL;
+	    }
+	    transpose64(tmp);
+	    for (ymuint b = 0; b < 64 && j * 64 + b < ni; ++ b) {
+	      ymuint pi = prim_map[j * 64 + b];
+	      if ( pi < np ) {
+		pbits[static_cast<ymuint64>(pi) * mb + w] = tmp[b];
+	      }
+	    }
+	  }
+	}
+      });
+
+    // 試行を並列に行う．
+    RandStream rs = rand_stream().split(r);
+    parallel_for(mTryNum, [&](ymuint begin, ymuint end) {
+	vector<ymuint> order(np);
+	vector<ymuint64> acc(mb);
+	vector<ymuint64> pc(mb + 1);
+	for (ymuint t = begin; t < end; ++ t) {
+	  gain_list[t] = 0;
+	  prefix_list[t].clear();
+	  if ( !running() ) {
+	    continue;
+	  }
+	  RandStream rg = rs.split(t);
+	  for (ymuint k = 0; k < np; ++ k) {
+	    order[k] = k;
+	  }
+	  for (ymuint w = 0; w < mb; ++ w) {
+	    acc[w] = 0ULL;
+	  }
+	  ymuint64 max_gain = 0;
+	  ymuint max_len = 0;
+	  for (ymuint k = 0; k < np; ++ k) {
+	    ymuint idx = k + rg.int32() % (np - k);
+	    std::swap(order[k], order[idx]);
+	    const ymuint64* src = &pbits[static_cast<ymuint64>(order[k]) * mb];
+	    for (ymuint w = 0; w < mb; ++ w) {
+	      acc[w] ^= src[w];
+	    }
+	    ymuint64 gain = calc_gain(&acc[0], mb, class_list, pc);
+	    if ( max_gain < gain ) {
+	      max_gain = gain;
+	      max_len = k + 1;
+	    }
+	  }
+	  gain_list[t] = max_gain;
+	  prefix_list[t].assign(order.begin(), order.begin() + max_len);
+	  consume(np, (sep_num + max_gain) / total);
+	}
+      });
+
+    // 最良の試行を選ぶ．同点の時は番号の小さい方とする．
+    ymuint best = 0;
+    for (ymuint t = 1; t < mTryNum; ++ t) {
+      if ( gain_list[best] < gain_list[t] ) {
+	best = t;
+      }
+    }
+    if ( gain_list[best] == 0 ) {
+      break;
+    }
+    const vector<ymuint>& prefix = prefix_list[best];
+    Variable var(ni, prim_list[prefix[0]]);
+    for (ymuint k = 1; k < prefix.size(); ++ k) {
+      var *= Variable(ni, prim_list[prefix[k]]);
+    }
+    var_list.push_back(var);
+    sep_num += gain_list[best];
+
+    // 分割を細かくする．
+    // 各クラスの中を 0 に分類されたもの，1 に分類されたものの順に並べる．
+    // 1要素となったクラスは捨てて残りを前に詰める．
+    for (ymuint w = 0; w < mb; ++ w) {
+      cur_bits[w] = 0ULL;
+    }
+    for (ymuint k = 0; k < prefix.size(); ++ k) {
+      const ymuint64* src = &pbits[static_cast<ymuint64>(prefix[k]) * mb];
+      for (ymuint w = 0; w < mb; ++ w) {
+	cur_bits[w] ^= src[w];
+      }
+    }
+    new_class_list.clear();
+    ymuint wpos = 0;
+    for (ymuint c = 0; c < class_list.size(); ++ c) {
+      const Range& range = class_list[c];
+      for (ymuint b = 0; b < 2; ++ b) {
+	ymuint start = wpos;
+	for (ymuint q = range.mBegin; q < range.mEnd; ++ q) {
+	  if ( ((cur_bits[q / 64] >> (q % 64)) & 1ULL) == b ) {
+	    new_perm[wpos] = perm[q];
+	    ++ wpos;
+	  }
+	}
+	if ( wpos - start >= 2 ) {
+	  Range range1;
+	  range1.mBegin = start;
+	  range1.mEnd = wpos;
+	  new_class_list.push_back(range1);
+	}
+	else {
+	  wpos = start;
+	}
+      }
+    }
+    m = wpos;
+    perm.swap(new_perm);
+    class_list.swap(new_class_list);
+  }
+  finish_budget();
+}
+
+// @brief 1つの変数あたりの試行回数を設定する．
+// @param[in] try_num 試行回数 ( > 0 )
+void
+Partition_LxGen::set_try_num(ymuint try_num)
+{
+  ASSERT_COND( try_num > 0 );
+  mTryNum = try_num;
+}
+
+END_NAMESPACE_IGF
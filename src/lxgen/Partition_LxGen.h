@@ -0,0 +1,93 @@
+#ifndef PARTITION_LXGEN_H
+#define PARTITION_LXGEN_H
+
+/// @file Partition_LxGen.h
+/// @brief Partition_LxGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "LxGenBase.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class Partition_LxGen Partition_LxGen.h "Partition_LxGen.h"
+/// @brief 登録ベクタの分割を細かくする順に合成変数を生成するクラス
+///
+/// それまでに選んだ変数による登録ベクタの分割(同じ値の組を持つベクタの
+/// クラス)を保持しておき，新たに分離されるベクタの対の数
+/// sum_C n1(C) * n0(C) が最大となる変数を次に選ぶ．
+/// 選んだ変数の線形結合は各クラス上で定数となり分離数が 0 となるので，
+/// 結果の変数は線形独立となる．
+///
+/// 登録ベクタはクラスごとに連続した位置に並べ替えておき，
+/// プライマリ変数の分類結果もその順に並べ替えたビットベクタで持つ．
+/// 1要素のクラスはそれ以上分割できないので，そのベクタは並びから除いて
+/// 残り(m 個)を前に詰める．並べ替えは行を64個ずつ集めて転置するので
+/// ワード単位で行える．
+/// 候補の分類結果は XOR で求まり，各クラスの n1 は累積 popcount の
+/// 差で求まるので，候補の評価は (m / 64 + クラス数) に比例する．
+/// クラスは2要素以上なのでクラス数は m / 2 以下となる．
+///
+/// 候補は Greedy_LxGen と同様にプライマリ変数をランダムな順に合成していき，
+/// その途中で分離数が最大となったものとする．これを1つの変数につき
+/// try_num 回(thread_num() 個のスレッドで分担して)行い，最良のものを選ぶ．
+/// 試行ごとの乱数の系列は rand_stream() から派生させるので，
+/// 結果はスレッド数によらない．
+//////////////////////////////////////////////////////////////////////
+class Partition_LxGen :
+  public LxGenBase
+{
+public:
+
+  /// @brief コンストラクタ
+  Partition_LxGen();
+
+  /// @brief デストラクタ
+  virtual
+  ~Partition_LxGen();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 合成変数の生成を行う．
+  /// @param[in] rv_list 登録ベクタのリスト
+  /// @param[in] req_num 生成する変数の数
+  /// @param[out] var_list 生成された変数を格納するリスト
+  ///
+  /// すべてのベクタが分離されるか，分離数を増やす変数が
+  /// 見つからなくなった時は req_num 個より少なくなる．
+  virtual
+  void
+  generate(const vector<const RegVect*>& rv_list,
+	   ymuint req_num,
+	   vector<Variable>& var_list);
+
+  /// @brief 1つの変数あたりの試行回数を設定する．
+  /// @param[in] try_num 試行回数 ( > 0 )
+  ///
+  /// デフォルトは 32
+  void
+  set_try_num(ymuint try_num);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 1つの変数あたりの試行回数
+  ymuint mTryNum;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // PARTITION_LXGEN_H
@@ -8,57 +8,40 @@
 
 
 #include "Shift_LxGen.h"
-#include "RegVect.h"
+#include "RvMatrix.h"
 #include "Variable.h"
 #include "VarHeap.h"
+#include "ClassBits.h"
+#include "ClassCounter.h"
 
 
 BEGIN_NAMESPACE_IGF
 
 BEGIN_NONAMESPACE
 
-ymuint
-calc_minval(const Variable& var1,
-	    const VarHeap& var_set,
-	    const vector<const RegVect*>& v_list)
+// var_set 中の変数との同時分布の最小値を求める．
+// counter は var_set 中の変数の分類結果を数えたもの
+//
+// 同時分布の各セルの和は counter から直接求まるので，
+// var_set 中の変数ごとに同時分布を求める必要はない．
+ymuint64
+calc_minval(const ClassBits& bits1,
+	    const ClassCounter& counter,
+	    ymuint64 nv)
 {
-  ymuint n00 = 0;
-  ymuint n01 = 0;
-  ymuint n10 = 0;
-  ymuint n11 = 0;
-  for (ymuint j = 0; j < var_set.size(); ++ j) {
-    const Variable& var2 = var_set.var(j);
-    for (vector<const RegVect*>::const_iterator p = v_list.begin();
-	 p != v_list.end(); ++ p) {
-      const RegVect* rv = *p;
-      if ( rv->classify(var1) ) {
-	if ( rv->classify(var2) ) {
-	  ++ n11;
-	}
-	else {
-	  ++ n10;
-	}
-      }
-      else {
-	if ( rv->classify(var2) ) {
-	  ++ n01;
-	}
-	else {
-	  ++ n00;
-	}
-      }
+  ymuint64 k = counter.num();
+  ymuint64 n1 = bits1.count1();
+  ymuint64 n_list[4];
+  n_list[3] = counter.count_and(bits1);
+  n_list[1] = n1 * k - n_list[3];
+  n_list[2] = counter.total() - n_list[3];
+  n_list[0] = nv * k - n_list[1] - n_list[2] - n_list[3];
+  ymuint64 min_n = n_list[0];
+  for (ymuint p = 1; p < 4; ++ p) {
+    if ( min_n > n_list[p] ) {
+      min_n = n_list[p];
     }
   }
-  ymuint min_n = n00;
-  if ( min_n > n01 ) {
-    min_n = n01;
-  }
-  if ( min_n > n10 ) {
-    min_n = n10;
-  }
-  if ( min_n > n11 ) {
-    min_n = n11;
-  }
   return min_n;
 }
 
@@ -79,100 +62,156 @@ Shift_LxGen::~Shift_LxGen()
 // @param[in] rv_list 登録ベクタのリスト
 // @param[in] req_num 生成する変数の数
 // @param[out] var_list 生成された変数を格納するリスト
+//
+// 変数の分類結果は ClassBits で保持しておき，
+// 候補(最悪の変数にプライマリ変数を合成したもの)の分類結果は XOR で求める．
+// 候補の評価は thread_num() 個のスレッドで分担して行うが，
+// 最良の候補の選択は候補の順に逐次的に行うので結果はスレッド数によらない．
+//
+// 上限のチェックは置き換えごとに行う．
+// 途中経過の価値は var_set 中の最小の価値とする．
 void
 Shift_LxGen::generate(const vector<const RegVect*>& rv_list,
 		      ymuint req_num,
 		      vector<Variable>& var_list)
 {
   ASSERT_COND( !rv_list.empty() );
-  ymuint ni = rv_list[0]->size();
+  start_budget();
+  RvMatrix rv_mat(rv_list);
+  ymuint64 nv = rv_mat.vect_num();
+  ymuint ni = rv_mat.vect_size();
   VarHeap var_set(ni);
-  for (ymuint i = 0; i < ni; ++ i) {
-    Variable var1(ni, i);
-    ymuint n0 = 0;
-    ymuint n1 = 0;
-    for (vector<const RegVect*>::const_iterator p = rv_list.begin();
-	 p != rv_list.end(); ++ p) {
-      const RegVect* rv = *p;
-      if ( rv->classify(var1) ) {
-	++ n1;
-      }
-      else {
-	++ n0;
-      }
+
+  // プライマリ変数の分類結果
+  vector<ClassBits> prim_bits(ni);
+  // var_set 中の変数の分類結果(VarTable の番号でアクセスする)
+  vector<ClassBits> set_bits;
+  // var_set 中の変数の価値(n0 * n1)(VarTable の番号でアクセスする)
+  // ヒープ木には double で入れるので順序付けにのみ用い，
+  // 値そのものはこちらを用いる．
+  vector<ymuint64> set_val;
+  // var_set 中の変数の分類結果を数えたもの
+  ClassCounter counter(rv_mat.column_size());
+
+  auto put_var = [&](const Variable& var,
+		     const ClassBits& bits,
+		     ymuint64 n2) {
+    var_set.put(var, static_cast<double>(n2));
+    ymuint id = var_set.var_table().find(var);
+    if ( id >= set_bits.size() ) {
+      set_bits.resize(id + 1);
+      set_val.resize(id + 1);
     }
+    set_bits[id] = bits;
+    set_val[id] = n2;
+    counter.add(bits);
+  };
+
+  for (ymuint i = 0; i < ni; ++ i) {
+    prim_bits[i].set_primary(rv_mat, i);
+    ymuint64 n1 = prim_bits[i].count1();
+    ymuint64 n0 = nv - n1;
     if ( n0 > 0 && n1 > 0 ) {
-      ymuint n2 = n0 * n1;
-      var_set.put(var1, n2);
+      ymuint64 n2 = n0 * n1;
+      put_var(Variable(ni, i), prim_bits[i], n2);
     }
   }
 
-  for ( ; ; ) {
-    ymuint n_old = var_set.value(0);
-    const Variable& var_old = var_set.var(0);
-    ymuint max_n = n_old + 1;
-    vector<Variable> max_vars;
+  // 1候補あたりの処理はブロック数に比例するので，
+  // 1スレッドあたり kGrainBlocks ブロック程度の仕事がない時は分割しない．
+  const ymuint kGrainBlocks = 16384;
+  ymuint grain = kGrainBlocks / (rv_mat.column_size() + 1) + 1;
+
+  vector<ymuint64> n2_list(ni);
+  vector<ClassBits> cand_bits(ni);
+  vector<ymuint64> minval_list(ni);
+  double n_ideal = static_cast<double>(nv) * static_cast<double>(nv) / 4.0;
+  while ( !var_set.empty() ) {
+    ymuint id_old = var_set.id(0);
+    ymuint64 n_old = set_val[id_old];
+    Variable var_old = var_set.var(0);
+    const ClassBits& bits_old = set_bits[id_old];
+
+    // 候補の評価は並列に行う．
+    // var_old に含まれる変数との合成は候補にならない．
+    parallel_for(ni, [&](ymuint begin, ymuint end) {
+	for (ymuint i = begin; i < end; ++ i) {
+	  if ( var_old.check_var(i) ) {
+	    continue;
+	  }
+	  ymuint64 n1 = bits_old.compose(prim_bits[i], cand_bits[i]);
+	  ymuint64 n0 = nv - n1;
+	  n2_list[i] = n0 * n1;
+	}
+      }, grain);
+
+    // 重複のチェックはハッシュ表で行う．
+    // 価値が最大値に届かない候補はチェックするまでもない．
+    ymuint64 max_n = n_old + 1;
+    vector<ymuint> max_pos_list;
     for (ymuint i = 0; i < ni; ++ i) {
-      Variable var1(ni, i);
-      if ( var1 && var_old ) {
+      if ( var_old.check_var(i) ) {
 	continue;
       }
-
-      var1 *= var_old;
-
-      bool found = false;
-      for (ymuint j = 0; j < var_set.size(); ++ j) {
-	const Variable& var2 = var_set.var(j);
-	if ( var1 == var2 ) {
-	  found = true;
-	  break;
-	}
-      }
-      if ( found ) {
+      ymuint64 n2 = n2_list[i];
+      if ( n2 < max_n ) {
 	continue;
       }
-
-      ymuint n0 = 0;
-      ymuint n1 = 0;
-      for (vector<const RegVect*>::const_iterator p = rv_list.begin();
-	   p != rv_list.end(); ++ p) {
-	const RegVect* rv = *p;
-	if ( rv->classify(var1) ) {
-	  ++ n1;
-	}
-	else {
-	  ++ n0;
-	}
+      if ( var_set.check(var_old * Variable(ni, i)) ) {
+	continue;
       }
-      ymuint n2 = n0 * n1;
       if ( max_n < n2 ) {
 	max_n = n2;
-	max_vars.clear();
-	max_vars.push_back(var1);
-      }
-      else if ( max_n == n2 ) {
-	max_vars.push_back(var1);
+	max_pos_list.clear();
       }
+      max_pos_list.push_back(i);
     }
-    if ( max_vars.empty() ) {
+    if ( !consume(ni, n_old / n_ideal) || max_pos_list.empty() ) {
       break;
     }
 
-    Variable max_var = max_vars[0];
-    ymuint n = max_vars.size();
+    ymuint max_pos = max_pos_list[0];
+    ymuint n = max_pos_list.size();
     if ( n > 1 ) {
-      ymuint max_min_n = calc_minval(max_var, var_set, rv_list);
-      for (ymuint i = 1; i < n; ++ i) {
-	const Variable& var1 = max_vars[i];
-	ymuint min_n = calc_minval(var1, var_set, rv_list);
-	if ( max_min_n < min_n ) {
-	  max_min_n = min_n;
-	  max_var = var1;
+      // 同点の候補は var_set との同時分布で比較する．
+      parallel_for(n, [&](ymuint begin, ymuint end) {
+	  for (ymuint j = begin; j < end; ++ j) {
+	    ymuint i = max_pos_list[j];
+	    minval_list[i] = calc_minval(cand_bits[i], counter, nv);
+	  }
+	}, grain);
+      ymuint64 max_min_n = minval_list[max_pos];
+      for (ymuint j = 1; j < n; ++ j) {
+	ymuint i = max_pos_list[j];
+	if ( max_min_n < minval_list[i] ) {
+	  max_min_n = minval_list[i];
+	  max_pos = i;
 	}
       }
     }
+
+    Variable max_var = var_old * Variable(ni, max_pos);
+    counter.sub(bits_old);
+    set_bits[id_old] = ClassBits();
     var_set.pop_min();
-    var_set.put(max_var, max_n);
+    put_var(max_var, cand_bits[max_pos], max_n);
+
+    if ( var_set.var_table().num() >= ni * 4 ) {
+      // 取り除いた変数が溜まったので表を作り直す．
+      vector<ymuint> id_map;
+      var_set.compact(id_map);
+      vector<ClassBits> new_bits(var_set.size());
+      vector<ymuint64> new_val(var_set.size());
+      for (ymuint id = 0; id < id_map.size(); ++ id) {
+	ymuint new_id = id_map[id];
+	if ( new_id != VarTable::kNoId ) {
+	  new_bits[new_id] = set_bits[id];
+	  new_val[new_id] = set_val[id];
+	}
+      }
+      set_bits.swap(new_bits);
+      set_val.swap(new_val);
+    }
   }
 
   var_list.clear();
@@ -180,6 +219,7 @@ Shift_LxGen::generate(const vector<const RegVect*>& rv_list,
   for (ymuint i = 0; i < var_set.size(); ++ i) {
     var_list.push_back(var_set.var(i));
   }
+  finish_budget();
 }
 
 END_NAMESPACE_IGF
@@ -9,7 +9,7 @@
 /// All rights reserved.
 
 
-#include "LxGen.h"
+#include "LxGenBase.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -19,7 +19,7 @@ BEGIN_NAMESPACE_IGF
 /// @brief 線形変換用の合成変数を生成するクラス
 //////////////////////////////////////////////////////////////////////
 class Shift_LxGen :
-  public LxGen
+  public LxGenBase
 {
 public:
 
@@ -10,7 +10,6 @@
 
 
 #include "LxGenBase.h"
-#include "ym/RandGen.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -53,9 +52,6 @@ private:
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
-  // 変数を選ぶための乱数発生器
-  RandGen mRandGen;
-
 };
 
 END_NAMESPACE_IGF
@@ -0,0 +1,244 @@
+
+/// @file Tempering_LxGen.cc
+/// @brief Tempering_LxGen の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "Tempering_LxGen.h"
+#include "VarPool.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_IGF
+
+BEGIN_NONAMESPACE
+
+// 決まった数のスレッドが揃うまで待ち合わせるバリア
+// 何度でも繰り返して使える．
+class Barrier
+{
+public:
+
+  // コンストラクタ
+  explicit
+  Barrier(ymuint num) :
+    mNum(num),
+    mCount(0),
+    mGeneration(0)
+  {
+  }
+
+  // 全スレッドが wait() を呼ぶまで待つ．
+  void
+  wait()
+  {
+    std::unique_lock<std::mutex> lock(mMutex);
+    ymuint64 gen = mGeneration;
+    ++ mCount;
+    if ( mCount == mNum ) {
+      mCount = 0;
+      ++ mGeneration;
+      mCond.notify_all();
+    }
+    else {
+      mCond.wait(lock, [this, gen]() { return mGeneration != gen; });
+    }
+  }
+
+private:
+
+  // 待ち合わせるスレッド数
+  ymuint mNum;
+
+  // 到着したスレッド数
+  ymuint mCount;
+
+  // 待ち合わせの世代
+  ymuint64 mGeneration;
+
+  std::mutex mMutex;
+
+  std::condition_variable mCond;
+
+};
+
+END_NONAMESPACE
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Tempering_LxGen
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+Tempering_LxGen::Tempering_LxGen() :
+  mMinTemp(1.0e-3),
+  mMaxTemp(0.1),
+  mReplicaNum(8),
+  mInterval(50)
+{
+}
+
+// @brief デストラクタ
+Tempering_LxGen::~Tempering_LxGen()
+{
+}
+
+// @brief 温度の範囲を設定する．
+// @param[in] min_temp 最低温度
+// @param[in] max_temp 最高温度 ( 0.0 < min_temp <= max_temp )
+void
+Tempering_LxGen::set_temperature(double min_temp,
+				 double max_temp)
+{
+  ASSERT_COND( min_temp > 0.0 && min_temp <= max_temp );
+  mMinTemp = min_temp;
+  mMaxTemp = max_temp;
+}
+
+// @brief レプリカ数を設定する．
+// @param[in] replica_num レプリカ数 ( >= 2 )
+void
+Tempering_LxGen::set_replica_num(ymuint replica_num)
+{
+  ASSERT_COND( replica_num >= 2 );
+  mReplicaNum = replica_num;
+}
+
+// @brief 交換を試みる間隔を設定する．
+// @param[in] interval 遷移の回数 ( > 0 )
+void
+Tempering_LxGen::set_exchange_interval(ymuint interval)
+{
+  ASSERT_COND( interval > 0 );
+  mInterval = interval;
+}
+
+// @brief 合成変数の生成を行う．
+// @param[in] rv_list 登録ベクタのリスト
+// @param[in] req_num 生成する変数の数
+// @param[out] var_list 生成された変数を格納するリスト
+void
+Tempering_LxGen::generate(const vector<const RegVect*>& rv_list,
+			  ymuint req_num,
+			  vector<Variable>& var_list)
+{
+  start_budget();
+  init(rv_list);
+
+  ymuint nr = mReplicaNum;
+  mRgExchange = rand_stream().split(nr);
+  mReplicaList.clear();
+  mReplicaList.resize(nr);
+  mTempList.resize(nr);
+  for (ymuint r = 0; r < nr; ++ r) {
+    init_chain(r, mReplicaList[r]);
+    double x = static_cast<double>(r) / static_cast<double>(nr - 1);
+    mTempList[r] = mMinTemp * pow(mMaxTemp / mMinTemp, x);
+  }
+
+  // レプリカごとのプールに貯めてから一つにまとめる．
+  vector<VarPool*> pool_list(nr);
+  for (ymuint r = 0; r < nr; ++ r) {
+    pool_list[r] = new VarPool(req_num);
+    pool_list[r]->put(mReplicaList[r].mCurState, mReplicaList[r].mCurVal);
+  }
+
+  // tid 番目のスレッドは r % tnum == tid のレプリカを受け持つ．
+  // スレッドは最後まで使い回し，1回分の遷移が終わるごとにバリアで揃える．
+  // 交換と継続の判定は 0 番目のスレッドが2つのバリアの間で行うので，
+  // done, round, go を他のスレッドが読むのはバリアを抜けた後だけとなる．
+  ymuint tnum = thread_num();
+  if ( tnum > nr ) {
+    tnum = nr;
+  }
+  ymuint step_num = this->step_num(req_num);
+  ymuint done = 0;
+  ymuint round = 0;
+  bool go = done < step_num && running();
+  Barrier barrier(tnum);
+  auto run = [&](ymuint tid) {
+    while ( go ) {
+      ymuint n = step_num - done;
+      if ( n > mInterval ) {
+	n = mInterval;
+      }
+      for (ymuint r = tid; r < nr; r += tnum) {
+	Chain& chain = mReplicaList[r];
+	double temp = mTempList[r];
+	VarPool& var_pool = *pool_list[r];
+	for (ymuint i = 0; i < n; ++ i) {
+	  metropolis_move(chain, temp);
+	  var_pool.put(chain.mCurState, chain.mCurVal);
+	  if ( !count_step(chain) ) {
+	    break;
+	  }
+	}
+      }
+      barrier.wait();
+      if ( tid == 0 ) {
+	exchange(round % 2);
+	done += mInterval;
+	++ round;
+	go = done < step_num && running();
+      }
+      barrier.wait();
+    }
+  };
+  vector<std::thread> thread_list;
+  thread_list.reserve(tnum);
+  for (ymuint tid = 1; tid < tnum; ++ tid) {
+    thread_list.push_back(std::thread(run, tid));
+  }
+  run(0);
+  for (ymuint i = 0; i < thread_list.size(); ++ i) {
+    thread_list[i].join();
+  }
+
+  VarPool var_pool(req_num);
+  for (ymuint r = 0; r < nr; ++ r) {
+    flush_step(mReplicaList[r]);
+    VarPool& pool1 = *pool_list[r];
+    for (ymuint i = 0; i < pool1.size(); ++ i) {
+      var_pool.put(pool1.var(i), pool1.value(i));
+    }
+    delete pool_list[r];
+  }
+  mReplicaList.clear();
+
+  var_list.clear();
+  var_list.reserve(var_pool.size());
+  for (ymuint i = 0; i < var_pool.size(); ++ i) {
+    var_list.push_back(var_pool.var(i));
+  }
+  finish_budget();
+}
+
+// @brief 隣り合うレプリカの交換を試みる．
+// @param[in] parity 0 なら (0, 1), (2, 3), ... 1 なら (1, 2), (3, 4), ...
+//
+// 乱数の系列はレプリカに付随させたまま状態のみを交換する．
+void
+Tempering_LxGen::exchange(ymuint parity)
+{
+  ymuint nr = mReplicaList.size();
+  for (ymuint r = parity; r + 1 < nr; r += 2) {
+    Chain& chain1 = mReplicaList[r];
+    Chain& chain2 = mReplicaList[r + 1];
+    double delta = (chain2.mCurVal - chain1.mCurVal) *
+      (1.0 / mTempList[r] - 1.0 / mTempList[r + 1]);
+    if ( delta < 0.0 && mRgExchange.real1() > exp(delta) ) {
+      continue;
+    }
+    std::swap(chain1.mCurState, chain2.mCurState);
+    chain1.mCurBits.swap(chain2.mCurBits);
+    std::swap(chain1.mCurVal, chain2.mCurVal);
+  }
+}
+
+END_NAMESPACE_IGF
@@ -0,0 +1,120 @@
+#ifndef TEMPERING_LXGEN_H
+#define TEMPERING_LXGEN_H
+
+/// @file Tempering_LxGen.h
+/// @brief Tempering_LxGen のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "MCMC_LxGen.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class Tempering_LxGen Tempering_LxGen.h "Tempering_LxGen.h"
+/// @brief レプリカ交換法(parallel tempering)で合成変数を生成するクラス
+///
+/// 温度の異なる複数の連鎖(レプリカ)を同時に動かし，
+/// 一定回数の遷移ごとに隣り合う温度のレプリカの状態を
+/// exp((v_j - v_i) * (1/T_i - 1/T_j)) の確率で交換する．
+/// 温度は最低温度から最高温度まで等比的に並べる．
+///
+/// 交換の間の遷移は thread_num() 個のスレッドで
+/// レプリカを分担して行い，交換は全スレッドの終了後に行う．
+/// スレッドは最初に一度だけ作り，交換の前後はバリアで同期する．
+/// レプリカ r は rand_stream().split(r) を，
+/// 交換の判定は rand_stream().split(レプリカ数) を用いる．
+/// 結果はスレッド数によらない．
+//////////////////////////////////////////////////////////////////////
+class Tempering_LxGen :
+  public MCMC_LxGen
+{
+public:
+
+  /// @brief コンストラクタ
+  Tempering_LxGen();
+
+  /// @brief デストラクタ
+  virtual
+  ~Tempering_LxGen();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 合成変数の生成を行う．
+  /// @param[in] rv_list 登録ベクタのリスト
+  /// @param[in] req_num 生成する変数の数
+  /// @param[out] var_list 生成された変数を格納するリスト
+  void
+  generate(const vector<const RegVect*>& rv_list,
+	   ymuint req_num,
+	   vector<Variable>& var_list);
+
+  /// @brief 温度の範囲を設定する．
+  /// @param[in] min_temp 最低温度
+  /// @param[in] max_temp 最高温度 ( 0.0 < min_temp <= max_temp )
+  void
+  set_temperature(double min_temp,
+		  double max_temp);
+
+  /// @brief レプリカ数を設定する．
+  /// @param[in] replica_num レプリカ数 ( >= 2 )
+  void
+  set_replica_num(ymuint replica_num);
+
+  /// @brief 交換を試みる間隔を設定する．
+  /// @param[in] interval 遷移の回数 ( > 0 )
+  void
+  set_exchange_interval(ymuint interval);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 隣り合うレプリカの交換を試みる．
+  /// @param[in] parity 0 なら (0, 1), (2, 3), ... 1 なら (1, 2), (3, 4), ...
+  void
+  exchange(ymuint parity);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 最低温度
+  double mMinTemp;
+
+  // 最高温度
+  double mMaxTemp;
+
+  // レプリカ数
+  ymuint mReplicaNum;
+
+  // 交換の間隔
+  ymuint mInterval;
+
+  // 交換の受容判定用の乱数の系列
+  RandStream mRgExchange;
+
+  // レプリカのリスト
+  // 温度の低い順に並ぶ．
+  vector<Chain> mReplicaList;
+
+  // レプリカごとの温度
+  vector<double> mTempList;
+
+};
+
+END_NAMESPACE_IGF
+
+#endif // TEMPERING_LXGEN_H
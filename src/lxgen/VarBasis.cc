@@ -0,0 +1,90 @@
+
+/// @file VarBasis.cc
+/// @brief VarBasis の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "VarBasis.h"
+#include "Variable.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+// クラス VarBasis
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+// @param[in] var_size 入力数
+VarBasis::VarBasis(ymuint var_size)
+{
+  clear(var_size);
+}
+
+// @brief デストラクタ
+VarBasis::~VarBasis()
+{
+}
+
+// @brief 内容をクリアする．
+// @param[in] var_size 入力数
+void
+VarBasis::clear(ymuint var_size)
+{
+  mVarSize = var_size;
+  mBlockSize = (var_size + 63) / 64;
+  mRowArray.clear();
+  mPivotList.clear();
+  mTmp.resize(mBlockSize);
+}
+
+// @brief 線形独立なら変数を追加する．
+// @param[in] var 対象の変数
+// @return 追加した時 true を返す．
+bool
+VarBasis::add(const Variable& var)
+{
+  ymuint pivot = reduce(var);
+  if ( pivot == mVarSize ) {
+    return false;
+  }
+  mRowArray.insert(mRowArray.end(), mTmp.begin(), mTmp.end());
+  mPivotList.push_back(pivot);
+  return true;
+}
+
+// @brief 変数を作業領域に入れて簡約する．
+// @param[in] var 対象の変数
+// @return 簡約した結果の主成分の位置を返す．
+ymuint
+VarBasis::reduce(const Variable& var) const
+{
+  ASSERT_COND( var.var_size() == mVarSize );
+
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    mTmp[i] = var.raw_data(i);
+  }
+  ymuint r = mPivotList.size();
+  for (ymuint k = 0; k < r; ++ k) {
+    ymuint pivot = mPivotList[k];
+    if ( (mTmp[pivot / 64] >> (pivot % 64)) & 1ULL ) {
+      const ymuint64* row = &mRowArray[static_cast<ymuint64>(k) * mBlockSize];
+      // 主成分より前のブロックは 0 なので飛ばしてよい．
+      for (ymuint i = pivot / 64; i < mBlockSize; ++ i) {
+	mTmp[i] ^= row[i];
+      }
+    }
+  }
+  for (ymuint i = 0; i < mBlockSize; ++ i) {
+    ymuint64 w = mTmp[i];
+    if ( w != 0ULL ) {
+      return i * 64 + __builtin_ctzll(w);
+    }
+  }
+  return mVarSize;
+}
+
+END_NAMESPACE_IGF
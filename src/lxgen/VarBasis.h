@@ -0,0 +1,125 @@
+#ifndef VARBASIS_H
+#define VARBASIS_H
+
+/// @file VarBasis.h
+/// @brief VarBasis のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2016 Yusuke Matsunaga
+/// All rights reserved.
+
+
+#include "igf.h"
+
+
+BEGIN_NAMESPACE_IGF
+
+//////////////////////////////////////////////////////////////////////
+/// @class VarBasis VarBasis.h "VarBasis.h"
+/// @brief 線形独立な変数の集合を GF(2) 上の階段形で保持するクラス
+///
+/// 変数のビットベクタを1行とし，各行に主成分(pivot)の位置を持つ．
+/// 行は追加した順に並び，各行は前の行の主成分の位置が 0 になるように
+/// 簡約してから追加するので，候補を前の行から順に簡約すれば
+/// 従属性の判定が rank * (var_size / 64) 回の XOR で行える．
+//////////////////////////////////////////////////////////////////////
+class VarBasis
+{
+public:
+
+  /// @brief コンストラクタ
+  /// @param[in] var_size 入力数
+  explicit
+  VarBasis(ymuint var_size = 0);
+
+  /// @brief デストラクタ
+  ~VarBasis();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 内容をクリアする．
+  /// @param[in] var_size 入力数
+  void
+  clear(ymuint var_size);
+
+  /// @brief 階数(保持している変数の数)を返す．
+  ymuint
+  rank() const;
+
+  /// @brief 変数が今の集合と線形独立か調べる．
+  /// @param[in] var 対象の変数
+  bool
+  check(const Variable& var) const;
+
+  /// @brief 線形独立なら変数を追加する．
+  /// @param[in] var 対象の変数
+  /// @return 追加した時 true を返す．
+  bool
+  add(const Variable& var);
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 変数を作業領域に入れて簡約する．
+  /// @param[in] var 対象の変数
+  /// @return 簡約した結果の主成分の位置を返す．
+  ///
+  /// 簡約した結果が 0 の時は mVarSize を返す．
+  ymuint
+  reduce(const Variable& var) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 入力数
+  ymuint mVarSize;
+
+  // 1行のブロック数
+  ymuint mBlockSize;
+
+  // 行の本体(rank() * mBlockSize ブロック)
+  vector<ymuint64> mRowArray;
+
+  // 各行の主成分の位置
+  vector<ymuint> mPivotList;
+
+  // 作業領域
+  mutable vector<ymuint64> mTmp;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 階数(保持している変数の数)を返す．
+inline
+ymuint
+VarBasis::rank() const
+{
+  return mPivotList.size();
+}
+
+// @brief 変数が今の集合と線形独立か調べる．
+// @param[in] var 対象の変数
+inline
+bool
+VarBasis::check(const Variable& var) const
+{
+  return reduce(var) < mVarSize;
+}
+
+END_NAMESPACE_IGF
+
+#endif // VARBASIS_H
@@ -88,10 +88,15 @@ void
 VarHeap::put(const Variable& var,
 	     double value)
 {
-  for(ymuint i = 0; i < mVarNum; ++ i) {
-    if ( mHeap[i].mVar == var ) {
-      // 同じものがすでに入っていた．
-      return;
+  ymuint id = mVarTable.find(var);
+  if ( id != VarTable::kNoId && mInHeap[id] ) {
+    // 同じものがすでに入っていた．
+    return;
+  }
+  if ( id == VarTable::kNoId ) {
+    id = mVarTable.intern(var);
+    if ( id >= mInHeap.size() ) {
+      mInHeap.resize(id + 1, false);
     }
   }
 
@@ -103,9 +108,38 @@ VarHeap::put(const Variable& var,
   // 末尾に追加して上に上げる．
   ymuint pos = mVarNum;
   ++ mVarNum;
-  mHeap[pos].mVar = var;
+  mHeap[pos].mId = id;
   mHeap[pos].mValue = value;
   move_up(pos);
+  mInHeap[id] = true;
+}
+
+// @brief 変数の表をヒープ木中の変数のみで作り直す．
+// @param[out] id_map 古い番号から新しい番号への対応表
+void
+VarHeap::compact(vector<ymuint>& id_map)
+{
+  id_map.clear();
+  id_map.resize(mVarTable.num(), VarTable::kNoId);
+  VarTable new_table(mVarTable.var_size());
+  for (ymuint pos = 0; pos < mVarNum; ++ pos) {
+    Node& node = mHeap[pos];
+    ymuint new_id = new_table.intern(mVarTable.body(node.mId));
+    id_map[node.mId] = new_id;
+    node.mId = new_id;
+  }
+  mVarTable = std::move(new_table);
+  mInHeap.clear();
+  mInHeap.resize(mVarNum, true);
+}
+
+// @brief 変数を含んでいる時 true を返す．
+// @param[in] var 変数
+bool
+VarHeap::check(const Variable& var) const
+{
+  ymuint id = mVarTable.find(var);
+  return id != VarTable::kNoId && mInHeap[id];
 }
 
 // @brief 値が最小の要素を取り出す．
@@ -114,6 +148,7 @@ void
 VarHeap::pop_min()
 {
   ASSERT_COND( !empty() );
+  mInHeap[mHeap[0].mId] = false;
   -- mVarNum;
   if ( mVarNum > 0 ) {
     mHeap[0] = mHeap[mVarNum];
@@ -149,8 +184,7 @@ VarHeap::print(ostream& s)
   s << "*** VarHeap ***" << endl
     << " size() = " << size() << endl;
   for (ymuint i = 0; i < size(); ++ i) {
-    const Variable& var1 = var(i);
-    s << var1 << ": value = " << mHeap[i].mValue << endl;
+    s << var(i) << ": value = " << mHeap[i].mValue << endl;
   }
   s << endl;
 }
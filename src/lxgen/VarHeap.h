@@ -11,6 +11,7 @@
 
 #include "igf.h"
 #include "Variable.h"
+#include "VarTable.h"
 
 
 BEGIN_NAMESPACE_IGF
@@ -18,6 +19,11 @@ BEGIN_NAMESPACE_IGF
 //////////////////////////////////////////////////////////////////////
 /// @class VarHeap VarHeap.h "VarHeap.h"
 /// @brief 変数のヒープ木
+///
+/// 変数の実体は VarTable に登録し，ヒープ木には番号のみを持つ．
+/// 重複のチェックは番号で行う．
+/// pop_min() で取り除いた変数も表には残るので，
+/// 溜まってきたら compact() で表を作り直す．
 //////////////////////////////////////////////////////////////////////
 class VarHeap
 {
@@ -42,9 +48,25 @@ public:
 
   /// @brief 変数を返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < size() )
-  const Variable&
+  Variable
   var(ymuint pos) const;
 
+  /// @brief 変数の番号を返す．
+  /// @param[in] pos 位置番号 ( 0 <= pos < size() )
+  ///
+  /// 番号は var_table() 中のもの
+  ymuint
+  id(ymuint pos) const;
+
+  /// @brief 変数の表を返す．
+  const VarTable&
+  var_table() const;
+
+  /// @brief 変数を含んでいる時 true を返す．
+  /// @param[in] var 変数
+  bool
+  check(const Variable& var) const;
+
   /// @brief 価値を返す．
   /// @param[in] pos 位置番号 ( 0 <= pos < size() )
   double
@@ -66,6 +88,15 @@ public:
   void
   pop_min();
 
+  /// @brief 変数の表をヒープ木中の変数のみで作り直す．
+  /// @param[out] id_map 古い番号から新しい番号への対応表
+  ///
+  /// ヒープ木中にない変数の番号には VarTable::kNoId が入る．
+  /// それまでの番号は無効となるので，番号で引いている情報は
+  /// id_map を用いて付け替えること．
+  void
+  compact(vector<ymuint>& id_map);
+
   /// @brief 内容を出力する．
   /// @param[in] s 出力先のストリーム
   void
@@ -79,7 +110,7 @@ private:
 
   struct Node
   {
-    Variable mVar;
+    ymuint mId;
     double mValue;
     Node* mLink;
   };
@@ -125,6 +156,12 @@ private:
   // ヒープ木中にある変数の数
   ymuint mVarNum;
 
+  // 変数の表
+  VarTable mVarTable;
+
+  // 番号ごとにヒープ木中にあるかどうかを表す配列
+  vector<bool> mInHeap;
+
 };
 
 
@@ -143,11 +180,28 @@ VarHeap::size() const
 // @brief 変数を返す．
 // @param[in] pos 位置番号 ( 0 <= pos < size() )
 inline
-const Variable&
+Variable
 VarHeap::var(ymuint pos) const
+{
+  return mVarTable.var(id(pos));
+}
+
+// @brief 変数の番号を返す．
+// @param[in] pos 位置番号 ( 0 <= pos < size() )
+inline
+ymuint
+VarHeap::id(ymuint pos) const
 {
   ASSERT_COND( pos < size() );
-  return mHeap[pos].mVar;
+  return mHeap[pos].mId;
+}
+
+// @brief 変数の表を返す．
+inline
+const VarTable&
+VarHeap::var_table() const
+{
+  return mVarTable;
 }
 
 // @brief 価値を返す．